@@ -19,6 +19,7 @@
 #define BWIDGETS_DEVICE_HPP_
 
 #include <chrono>
+#include <cstdint>
 
 namespace BDevices 
 {
@@ -75,6 +76,18 @@ public:
      */
     DeviceType getDeviceType () const {return type_;}
 
+    /**
+     * @brief Get a numerical identifier of the device type and its 
+     * parameter type.
+     * 
+     * @return  Device identifier.
+     *
+     * Devices with the same identifier are equal. Inherriting classes with
+     * an additional parameter type (and an overridden @a less() method)
+     * must also override this method.
+     */
+    virtual uint64_t getId () const {return static_cast<uint64_t>(type_) << 32;}
+
     /**
      * @brief Set the time point of the last device action manually
      * 
@@ -0,0 +1,153 @@
+/* DeviceTable.hpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BWIDGETS_DEVICETABLE_HPP_
+#define BWIDGETS_DEVICETABLE_HPP_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Device.hpp"
+
+namespace BDevices
+{
+
+/**
+ * @brief  Small table of device objects. Stores a clone of each device and
+ * holds at most one device object for each device identifier (see
+ * @a Device::getId() ).
+ *
+ * Lookup compares numerical device identifiers only. As widgets typically
+ * only hold a few devices, the table is a flat vector.
+ */
+class DeviceTable
+{
+protected:
+    std::vector<std::pair<uint64_t, Device*>> devices_;
+
+public:
+    typedef std::vector<std::pair<uint64_t, Device*>>::const_iterator const_iterator;
+
+    /**
+     * @brief  Construct an empty DeviceTable object.
+     */
+    DeviceTable () : devices_() {}
+
+    DeviceTable (const DeviceTable& that) = delete;
+
+    DeviceTable& operator= (const DeviceTable& that) = delete;
+
+    ~DeviceTable () {clear();}
+
+    /**
+     * @brief  Stores a clone of a device. Replaces an equal device object
+     * if present.
+     *
+     * @param device  Device.
+     * @return  Pointer to the stored clone.
+     */
+    Device* insert (const Device& device);
+
+    /**
+     * @brief  Removes and deletes the device object which is equal to
+     * @a device .
+     *
+     * @param device  Device.
+     * @return  True if a device object was removed, otherwise false.
+     */
+    bool erase (const Device& device);
+
+    /**
+     * @brief  Removes and deletes all device objects.
+     */
+    void clear ();
+
+    /**
+     * @brief  Get access to the device object which is equal to @a device.
+     *
+     * @param device  Device.
+     * @return  Pointer to the device object, or nullptr if no matching
+     * device.
+     */
+    Device* find (const Device& device) const;
+
+    /**
+     * @brief  Checks if the table is empty.
+     *
+     * @return  True if empty, otherwise false.
+     */
+    bool empty () const {return devices_.empty();}
+
+    const_iterator begin () const {return devices_.cbegin();}
+
+    const_iterator end () const {return devices_.cend();}
+};
+
+inline Device* DeviceTable::insert (const Device& device)
+{
+    const uint64_t id = device.getId();
+    Device* d = device.clone();
+    for (std::pair<uint64_t, Device*>& p : devices_)
+    {
+        if (p.first == id)
+        {
+            delete p.second;
+            p.second = d;
+            return d;
+        }
+    }
+
+    devices_.push_back (std::make_pair (id, d));
+    return d;
+}
+
+inline bool DeviceTable::erase (const Device& device)
+{
+    const uint64_t id = device.getId();
+    for (std::vector<std::pair<uint64_t, Device*>>::iterator it = devices_.begin(); it != devices_.end(); ++it)
+    {
+        if (it->first == id)
+        {
+            delete it->second;
+            devices_.erase (it);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline void DeviceTable::clear ()
+{
+    for (std::pair<uint64_t, Device*>& p : devices_) delete p.second;
+    devices_.clear();
+}
+
+inline Device* DeviceTable::find (const Device& device) const
+{
+    const uint64_t id = device.getId();
+    for (const std::pair<uint64_t, Device*>& p : devices_)
+    {
+        if (p.first == id) return p.second;
+    }
+
+    return nullptr;
+}
+
+}
+
+#endif /* BWIDGETS_DEVICETABLE_HPP_ */
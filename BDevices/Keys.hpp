@@ -120,6 +120,14 @@ public:
 	 */
 	KeyType getKey() const {return key_;}
 
+	/**
+	 * @brief Get a numerical identifier of the device type and its 
+	 * parameter type (key).
+	 * 
+	 * @return  Device identifier.
+	 */
+	virtual uint64_t getId () const override {return Device::getId() | static_cast<uint32_t>(key_);}
+
 	/**
 	 * @brief  Get the KeyType for a provided key code.
 	 * @param keyCode  Key code.
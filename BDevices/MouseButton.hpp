@@ -76,6 +76,14 @@ public:
 	 */
     ButtonType getButton() const;
 
+    /**
+     * @brief Get a numerical identifier of the device type and its 
+     * parameter type (button).
+     * 
+     * @return  Device identifier.
+     */
+    virtual uint64_t getId () const override;
+
     /**
      * @brief Compares this and another device object.
      * 
@@ -140,6 +148,11 @@ inline MouseButton::ButtonType MouseButton::getButton() const
     return button_;
 }
 
+inline uint64_t MouseButton::getId () const
+{
+    return Device::getId() | static_cast<uint32_t>(button_);
+}
+
 inline bool MouseButton::less (const Device& rhs) const
 {
     // lhs.type_ != rhs.type_ ?
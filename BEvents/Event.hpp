@@ -18,16 +18,20 @@
 #ifndef BEVENTS_EVENT_HPP_
 #define BEVENTS_EVENT_HPP_
 
+#include <cstddef>
 #include <cstdint>
 
 namespace BWidgets
 {
-class Widget;	// Forward declaration
+class Widget;			// Forward declaration
+class EventQueueable;	// Forward declaration
 }
 
 namespace BEvents
 {
 
+class EventPool;	// Forward declaration
+
 /**
  *  @brief  Main class of events. 
  *
@@ -76,6 +80,13 @@ protected:
 	BWidgets::Widget* eventWidget_;
 	EventType eventType_;
 
+private:
+	friend class EventPool;
+	friend class BWidgets::EventQueueable;
+	EventPool* pool_;
+	size_t poolSizeClass_;
+	BWidgets::EventQueueable* queue_;
+	size_t queuePosition_;
 
 public:
 
@@ -94,11 +105,31 @@ public:
      *  @param type  EventType.
 	 */
 	Event (BWidgets::Widget* widget, const EventType type) :
-		eventWidget_ (widget), eventType_ (type) 
+		eventWidget_ (widget), eventType_ (type), pool_ (nullptr), poolSizeClass_ (0), queue_ (nullptr), queuePosition_ (0) 
     {
 
     }
 
+	/**
+	 *  @brief  Creates a copy of an %Event.
+	 *  @param that  Other %Event.
+	 *
+	 *  The copy doesn't take over the memory management by an EventPool and
+	 *  isn't a member of an event queue.
+	 */
+	Event (const Event& that) :
+		eventWidget_ (that.eventWidget_), eventType_ (that.eventType_), pool_ (nullptr), poolSizeClass_ (0), queue_ (nullptr), queuePosition_ (0) 
+    {
+
+    }
+
+	Event& operator= (const Event& that)
+	{
+		eventWidget_ = that.eventWidget_;
+		eventType_ = that.eventType_;
+		return *this;
+	}
+
 	virtual ~Event () 
     {
 
@@ -0,0 +1,220 @@
+/* EventPool.hpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BEVENTS_EVENTPOOL_HPP_
+#define BEVENTS_EVENTPOOL_HPP_
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Event.hpp"
+
+#ifndef BEVENTS_EVENTPOOL_BLOCK_SIZE
+#define BEVENTS_EVENTPOOL_BLOCK_SIZE 16
+#endif
+
+namespace BEvents
+{
+
+/**
+ *  @brief  Pool of recyclable event memory blocks.
+ *
+ *  Events created by @c create() are constructed in memory blocks taken
+ *  from the pool. Released events are destructed and their memory blocks
+ *  are returned to the pool for re-use by the next event of the same size
+ *  class. Thus, once the pool is warmed up, event creation and release
+ *  don't allocate any more.
+ *
+ *  Events not created by a pool (e.g., by calling @c new) are also
+ *  accepted by @c dispose() and are deleted in this case.
+ *
+ *  Note: %EventPool is not thread-safe. Use it from the UI thread only.
+ */
+class EventPool
+{
+protected:
+    std::vector<std::vector<void*>> freeBlocks_;
+    size_t blocks_;
+
+public:
+
+    /**
+     *  @brief  Constructs an empty %EventPool.
+     */
+    EventPool ();
+
+    EventPool (const EventPool& that) = delete;
+
+    EventPool& operator= (const EventPool& that) = delete;
+
+    /**
+     *  @brief  Destructs the %EventPool and de-allocates all free memory
+     *  blocks.
+     *
+     *  All events created by this pool must be released before.
+     */
+    ~EventPool ();
+
+    /**
+     *  @brief  Creates an event of the type @a T in a pooled memory block.
+     *  @tparam T  Event type.
+     *  @param args  Parameters passed to the constructor of @a T .
+     *  @return  Pointer to the new event.
+     *
+     *  The returned event must not be deleted by calling @c delete. Use
+     *  @c dispose() instead.
+     */
+    template <class T, typename... Args>
+    T* create (Args&&... args);
+
+    /**
+     *  @brief  Allocates memory blocks in advance.
+     *  @tparam T  Event type.
+     *  @param n  Number of free memory blocks for events of type @a T .
+     */
+    template <class T>
+    void reserve (const size_t n);
+
+    /**
+     *  @brief  Gets the number of memory blocks owned by the pool.
+     *  @return  Number of memory blocks (free and in use).
+     */
+    size_t size () const;
+
+    /**
+     *  @brief  Gets the number of free memory blocks.
+     *  @return  Number of free memory blocks.
+     */
+    size_t available () const;
+
+    /**
+     *  @brief  Destructs an event and de-allocates its memory.
+     *  @param event  Pointer to the event.
+     *
+     *  Returns the memory block of @a event to its pool if the @a event was
+     *  created by an %EventPool. Otherwise calls @c delete.
+     */
+    static void dispose (Event* event);
+
+protected:
+    void release (Event* event);
+
+    template <class T>
+    static constexpr size_t sizeClass ();
+};
+
+inline EventPool::EventPool () :
+    freeBlocks_ (),
+    blocks_ (0)
+{
+
+}
+
+inline EventPool::~EventPool ()
+{
+    for (std::vector<void*>& v : freeBlocks_)
+    {
+        for (void* block : v) ::operator delete (block);
+    }
+}
+
+template <class T>
+inline constexpr size_t EventPool::sizeClass ()
+{
+    return (sizeof (T) + BEVENTS_EVENTPOOL_BLOCK_SIZE - 1) / BEVENTS_EVENTPOOL_BLOCK_SIZE;
+}
+
+template <class T, typename... Args>
+inline T* EventPool::create (Args&&... args)
+{
+    static_assert (std::is_base_of<Event, T>::value, "T must be derived from BEvents::Event");
+    static_assert (alignof (T) <= alignof (std::max_align_t), "Over-aligned events are not supported");
+
+    const size_t sc = sizeClass<T> ();
+    if (sc >= freeBlocks_.size()) freeBlocks_.resize (sc + 1);
+
+    void* block;
+    if (freeBlocks_[sc].empty())
+    {
+        block = ::operator new (sc * BEVENTS_EVENTPOOL_BLOCK_SIZE);
+        ++blocks_;
+    }
+
+    else
+    {
+        block = freeBlocks_[sc].back();
+        freeBlocks_[sc].pop_back();
+    }
+
+    T* event;
+    try {event = new (block) T (std::forward<Args>(args)...);}
+    catch (...)
+    {
+        freeBlocks_[sc].push_back (block);
+        throw;
+    }
+
+    event->pool_ = this;
+    event->poolSizeClass_ = sc;
+    return event;
+}
+
+template <class T>
+inline void EventPool::reserve (const size_t n)
+{
+    const size_t sc = sizeClass<T> ();
+    if (sc >= freeBlocks_.size()) freeBlocks_.resize (sc + 1);
+    freeBlocks_[sc].reserve (n);
+    while (freeBlocks_[sc].size() < n)
+    {
+        freeBlocks_[sc].push_back (::operator new (sc * BEVENTS_EVENTPOOL_BLOCK_SIZE));
+        ++blocks_;
+    }
+}
+
+inline size_t EventPool::size () const
+{
+    return blocks_;
+}
+
+inline size_t EventPool::available () const
+{
+    size_t n = 0;
+    for (const std::vector<void*>& v : freeBlocks_) n += v.size();
+    return n;
+}
+
+inline void EventPool::dispose (Event* event)
+{
+    if (!event) return;
+    if (event->pool_) event->pool_->release (event);
+    else delete event;
+}
+
+inline void EventPool::release (Event* event)
+{
+    const size_t sc = event->poolSizeClass_;
+    void* block = dynamic_cast<void*>(event);
+    event->~Event();
+    freeBlocks_[sc].push_back (block);
+}
+
+}
+
+#endif /* BEVENTS_EVENTPOOL_HPP_ */
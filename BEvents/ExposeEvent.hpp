@@ -20,6 +20,7 @@
 
 #include "WidgetEvent.hpp"
 #include "../BUtilities/Area.hpp"
+#include "../BUtilities/Region.hpp"
 
 namespace BEvents
 {
@@ -31,11 +32,14 @@ namespace BEvents
  *  content of a child (request) widget is requested to be updated. An 
  *  %ExposeEvent additionally contains the coordinates (x, y, width and height)
  *  of the output region (relative to the widgets origin) to be updated.
+ *  Merged %ExposeEvents keep the output region as a set of disjoint areas
+ *  (see @c getRegion() ).
  */
 class ExposeEvent : public WidgetEvent
 {
 protected:
 	BUtilities::Area<> exposeArea_;
+	BUtilities::Region<> exposeRegion_;
 
 public:
 
@@ -77,7 +81,8 @@ public:
 	ExposeEvent (BWidgets::Widget* eventWidget, BWidgets::Widget* requestWidget, const EventType type,
 		         const BUtilities::Area<>& area) :
 		WidgetEvent (eventWidget, requestWidget, type),
-		exposeArea_ (area) 
+		exposeArea_ (area),
+		exposeRegion_ (area) 
     {
 
     }
@@ -89,6 +94,7 @@ public:
 	virtual void setArea (const BUtilities::Area<>& area)
 	{
         exposeArea_ = area;
+        exposeRegion_ = BUtilities::Region<> (area);
     }
 
 	/**
@@ -99,6 +105,27 @@ public:
 	{
         return exposeArea_;
     }
+
+	/**
+	 *  @brief  Redefines the output region.
+	 *  @param region  Region relative to the widgets origin.
+	 *
+	 *  Also sets the area to the bounding box of @a region .
+	 */
+	virtual void setRegion (const BUtilities::Region<>& region)
+	{
+        exposeRegion_ = region;
+        exposeArea_ = region.getBoundingBox();
+    }
+
+	/**
+	 *  @brief  Gets the output region.
+	 *  @return  Region relative to the widgets origin.
+	 */
+	BUtilities::Region<> getRegion () const
+	{
+        return exposeRegion_;
+    }
 };
 
 }
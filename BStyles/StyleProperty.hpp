@@ -19,8 +19,10 @@
 #define BSTYLES_STYLEPROPERTY_HPP_
 
 #include <cstdint>
+#include <utility>
 #include "../BUtilities/Property.hpp"
 #include "../BUtilities/Any.hpp"
+#include "../BUtilities/Urid.hpp"
 
 #define BSTYLES_STYLEPROPERTY_URI "https://github.com/sjaehn/BWidgets/BStyles/StyleProperty.hpp"
 #define BSTYLES_STYLEPROPERTY_BACKGROUND_URI BSTYLES_STYLEPROPERTY_URI "#Backgound"
@@ -29,6 +31,16 @@
 #define BSTYLES_STYLEPROPERTY_FGCOLORS_URI BSTYLES_STYLEPROPERTY_URI "#FgColors"
 #define BSTYLES_STYLEPROPERTY_BGCOLORS_URI BSTYLES_STYLEPROPERTY_URI "#BgColors"
 #define BSTYLES_STYLEPROPERTY_TXCOLORS_URI BSTYLES_STYLEPROPERTY_URI "#TxColors"
+#define BSTYLES_STYLEPROPERTY_HICOLORS_URI BSTYLES_STYLEPROPERTY_URI "#HiColors"
+
+// Built-in style properties: URIDs are known at compile time
+#define BSTYLES_STYLEPROPERTY_BACKGROUND_URID (BUTILITIES_URID_UNKNOWN_URID + 1)
+#define BSTYLES_STYLEPROPERTY_BORDER_URID (BUTILITIES_URID_UNKNOWN_URID + 2)
+#define BSTYLES_STYLEPROPERTY_FONT_URID (BUTILITIES_URID_UNKNOWN_URID + 3)
+#define BSTYLES_STYLEPROPERTY_FGCOLORS_URID (BUTILITIES_URID_UNKNOWN_URID + 4)
+#define BSTYLES_STYLEPROPERTY_BGCOLORS_URID (BUTILITIES_URID_UNKNOWN_URID + 5)
+#define BSTYLES_STYLEPROPERTY_TXCOLORS_URID (BUTILITIES_URID_UNKNOWN_URID + 6)
+#define BSTYLES_STYLEPROPERTY_HICOLORS_URID (BUTILITIES_URID_UNKNOWN_URID + 7)
 
 namespace BStyles
 {
@@ -57,6 +69,38 @@ public:
     }
 
     StyleProperty& operator= (const StyleProperty&) = delete;
+
+private:
+    /**
+     *  @brief  Adds the URIs of the built-in style properties with their
+     *  fixed URIDs to the URID map.
+     *  @return  True on success, otherwise false.
+     */
+    static bool addBuiltInUrids ()
+    {
+        static_assert (BSTYLES_STYLEPROPERTY_HICOLORS_URID < BUTILITIES_URID_RESERVED_URIDS, "Too many built-in URIDs");
+        const std::pair<const char*, uint32_t> builtIns[] =
+        {
+            {BSTYLES_STYLEPROPERTY_BACKGROUND_URI, BSTYLES_STYLEPROPERTY_BACKGROUND_URID},
+            {BSTYLES_STYLEPROPERTY_BORDER_URI, BSTYLES_STYLEPROPERTY_BORDER_URID},
+            {BSTYLES_STYLEPROPERTY_FONT_URI, BSTYLES_STYLEPROPERTY_FONT_URID},
+            {BSTYLES_STYLEPROPERTY_FGCOLORS_URI, BSTYLES_STYLEPROPERTY_FGCOLORS_URID},
+            {BSTYLES_STYLEPROPERTY_BGCOLORS_URI, BSTYLES_STYLEPROPERTY_BGCOLORS_URID},
+            {BSTYLES_STYLEPROPERTY_TXCOLORS_URI, BSTYLES_STYLEPROPERTY_TXCOLORS_URID},
+            {BSTYLES_STYLEPROPERTY_HICOLORS_URI, BSTYLES_STYLEPROPERTY_HICOLORS_URID}
+        };
+
+        bool success = true;
+        for (const std::pair<const char*, uint32_t>& b : builtIns)
+        {
+            if (BUtilities::Urid::add (b.first, b.second) != b.second) success = false;
+        }
+        return success;
+    }
+
+    // Added during static initialization of each translation unit 
+    // including this header
+    static inline const bool builtInUrids_ = addBuiltInUrids ();
 };
 
 }
@@ -21,6 +21,7 @@
 #include "cairo/cairo.h"
 #include "../../BUtilities/cairoplus.h"
 #include "Color.hpp"
+#include <atomic>
 #include <string>
 
 namespace BStyles
@@ -29,7 +30,9 @@ namespace BStyles
 /**
  *  @brief %Fill base properties.
  *
- *  A %Fill may either be a color or an image.
+ *  A %Fill may either be a color or an image. Image surfaces are immutable and
+ *  shared between copies of a %Fill. Use getMutableSurface() to change the
+ *  image (copy-on-write).
  */
 class Fill
 {
@@ -42,8 +45,49 @@ protected:
 
     Color color_;
     cairo_surface_t* surface_;
+    std::atomic<size_t>* shares_;   // Number of Fills sharing surface_
     FillType type_;
 
+    /**
+     *  @brief  Takes over a newly created surface.
+     *  @param surface  Cairo surface or nullptr.
+     */
+    void setNewSurface (cairo_surface_t* surface)
+    {
+        releaseSurface ();
+        surface_ = surface;
+        if (surface_ && (cairo_surface_status (surface_) == CAIRO_STATUS_SUCCESS)) shares_ = new std::atomic<size_t> (1);
+    }
+
+    /**
+     *  @brief  Shares the surface of another %Fill.
+     *  @param that  Other %Fill.
+     */
+    void shareSurface (const Fill& that)
+    {
+        releaseSurface ();
+        if (that.shares_)
+        {
+            that.shares_->fetch_add (1, std::memory_order_relaxed);
+            shares_ = that.shares_;
+            surface_ = cairo_surface_reference (that.surface_);
+        }
+    }
+
+    /**
+     *  @brief  Releases the surface.
+     */
+    void releaseSurface ()
+    {
+        if (shares_)
+        {
+            if (shares_->fetch_sub (1, std::memory_order_acq_rel) == 1) delete shares_;
+            cairo_surface_destroy (surface_);
+        }
+        surface_ = nullptr;
+        shares_ = nullptr;
+    }
+
 public:
 
 	/**
@@ -52,6 +96,7 @@ public:
 	Fill () : 
         color_ (), 
         surface_ (nullptr),
+        shares_ (nullptr),
         type_ (FillType::color)
     {
 
@@ -64,6 +109,7 @@ public:
 	explicit Fill (const Color& color) : 
         color_ (color), 
         surface_ (nullptr),
+        shares_ (nullptr),
         type_ (FillType::color)
     {
 
@@ -73,16 +119,19 @@ public:
      *  @brief  Creates an image %Fill from a Cairo surface.
      *  @param surface  Cairo image surface.
      *
-     *  The constructor creates a copy of the Cairo image surface.
+     *  The constructor creates a copy of the Cairo image surface. Thus, 
+     *  @a surface may be changed or destroyed afterwards.
      */
 	explicit Fill (cairo_surface_t* surface) :
         color_ (),
-        surface_    (surface && (cairo_surface_status (surface) == CAIRO_STATUS_SUCCESS) ? 
-                     cairoplus_image_surface_clone_from_image_surface (surface) : 
-                     nullptr),
+        surface_ (nullptr),
+        shares_ (nullptr),
         type_ (FillType::image)
     {
-    
+        if (surface && (cairo_surface_status (surface) == CAIRO_STATUS_SUCCESS)) 
+        {
+            setNewSurface (cairoplus_image_surface_clone_from_image_surface (surface));
+        }
     }
 
     /**
@@ -91,49 +140,47 @@ public:
      */
 	explicit Fill (const std::string& filename) :
         color_ (),
-        surface_ (cairo_image_surface_create_from_png (filename.c_str())),
+        surface_ (nullptr),
+        shares_ (nullptr),
         type_ (FillType::image)
     {
-    
+        setNewSurface (cairo_image_surface_create_from_png (filename.c_str()));
     }
 
     /**
      *  @brief  Copy constructs a new %Fill from another one.
      *  @param that  %Fill to copy from.
+     *
+     *  The image surface (if exists) is shared with @a that.
      */
     Fill (const Fill& that) :
         color_ (that.color_),
-        surface_    (that.surface_ && (cairo_surface_status (that.surface_) == CAIRO_STATUS_SUCCESS) ? 
-                     cairoplus_image_surface_clone_from_image_surface (that.surface_) : 
-                     nullptr),
+        surface_ (nullptr),
+        shares_ (nullptr),
         type_ (that.type_)
     {
-    
+        shareSurface (that);
     }
 
     ~Fill ()
     {
-        if (surface_ && (cairo_surface_status (surface_) == CAIRO_STATUS_SUCCESS)) cairo_surface_destroy (surface_);
+        releaseSurface ();
     }
 
     /**
      *  @brief  Sets the %Fill by copying from another one.
      *  @param that  Source %Fill.
      *
-     *  Sets the %Fill by copying from another one. Frees the 
-     *  previously stored image source (if exists) first.
+     *  Sets the %Fill by copying from another one. Releases the 
+     *  previously stored image source (if exists) first. The image surface
+     *  (if exists) is shared with @a that.
      */
     Fill& operator= (const Fill& that)
     {
         color_ = that.color_;
         type_ = that.type_;
 
-        if (surface_ != that.surface_)
-        {
-            if (surface_ && (cairo_surface_status (surface_) == CAIRO_STATUS_SUCCESS)) cairo_surface_destroy (surface_);
-            if (that.surface_) surface_ = cairoplus_image_surface_clone_from_image_surface (that.surface_);
-            else surface_ = nullptr;
-        }
+        if (surface_ != that.surface_) shareSurface (that);
 
         return *this;
     }
@@ -154,8 +201,7 @@ public:
      */
     void set (const Color& color)
     {
-        if (surface_ && (cairo_surface_status (surface_) == CAIRO_STATUS_SUCCESS)) cairo_surface_destroy (surface_);
-        surface_ = nullptr;
+        releaseSurface ();
         color_ = color;
         type_ = FillType::color;
     }
@@ -173,9 +219,8 @@ public:
     {
         if (surface_ != surface)
         {
-            if (surface_ && (cairo_surface_status (surface_) == CAIRO_STATUS_SUCCESS)) cairo_surface_destroy (surface_);
-            if (surface) surface_ = cairoplus_image_surface_clone_from_image_surface (surface);
-            else surface_ = nullptr;
+            if (surface) setNewSurface (cairoplus_image_surface_clone_from_image_surface (surface));
+            else releaseSurface ();
         }
 
         type_ = FillType::image;
@@ -190,13 +235,64 @@ public:
      */
     void set (const std::string& filename)
     {
-        if (surface_ && (cairo_surface_status (surface_) == CAIRO_STATUS_SUCCESS)) cairo_surface_destroy (surface_);
-        if (filename != "") surface_ = cairo_image_surface_create_from_png (filename.c_str());
-        else surface_ = nullptr;
+        if (filename != "") setNewSurface (cairo_image_surface_create_from_png (filename.c_str()));
+        else releaseSurface ();
 
         type_ = FillType::image;
     }
 
+    /**
+     *  @brief  Tests if the %Fill is a plain single color.
+     *  @return  True if the %Fill is a color, false if it is an image.
+     */
+    bool isColor () const
+    {
+        return (type_ == FillType::color);
+    }
+
+    /**
+     *  @brief  Gets the color of a plain single color %Fill.
+     *  @return  Color.
+     */
+    Color getColor () const
+    {
+        return color_;
+    }
+
+    /**
+     *  @brief  Gets the image surface of an image %Fill.
+     *  @return  Pointer to the Cairo image surface or nullptr.
+     *
+     *  The surface may be shared with other %Fill objects and must not be 
+     *  changed. Use getMutableSurface() instead.
+     */
+    cairo_surface_t* getSurface () const
+    {
+        return surface_;
+    }
+
+    /**
+     *  @brief  Gets the image surface of an image %Fill for changing it.
+     *  @return  Pointer to the Cairo image surface or nullptr.
+     *
+     *  Copy-on-write: If the surface is shared with other %Fill objects, the 
+     *  %Fill gets its own copy of the surface first. Call 
+     *  cairo_surface_mark_dirty() after directly changing pixels. The
+     *  surface is only valid until the %Fill is changed, copied or
+     *  destructed.
+     */
+    cairo_surface_t* getMutableSurface ()
+    {
+        // Only the share count of the Fills matters. Cairo references (e.g.,
+        // by patterns) don't make a surface shared.
+        if (shares_ && (shares_->load (std::memory_order_acquire) > 1))
+        {
+            setNewSurface (cairoplus_image_surface_clone_from_image_surface (surface_));
+        }
+
+        return surface_;
+    }
+
     /**
      *  @brief  Sets the %Fill souce to a Cairo context.
      *  @param cr  Cairo context.
@@ -18,8 +18,17 @@
 #ifndef BUTILITIES_ANY_HPP_
 #define BUTILITIES_ANY_HPP_
 
+#include <algorithm>
+#include <atomic>
 #include <typeinfo>
 #include <iostream>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+#ifndef BUTILITIES_ANY_BUFFER_SIZE
+#define BUTILITIES_ANY_BUFFER_SIZE 64
+#endif
 
 namespace BUtilities
 {
@@ -28,6 +37,11 @@ namespace BUtilities
  *  @brief  Container to type-safely take up the content of any copy 
  *  constructible type.
  *
+ *  Small trivially copyable data (up to BUTILITIES_ANY_BUFFER_SIZE bytes,
+ *  e. g. colors, lines, borders) are stored within the object. Other data
+ *  are stored on the heap. As the content can't be changed (only replaced
+ *  by set()), copies share the heap stored data.
+ *
  *  @note  Similar classes are in the std (C++>=17) and boost.
  */
 class Any
@@ -35,25 +49,69 @@ class Any
 protected:
         struct Envelope
         {
+                std::atomic<size_t> references {1};
                 virtual ~Envelope () {}
-                virtual Envelope* clone () {return new Envelope (*this);}
         };
 
         template <class T> struct Data : Envelope
         {
                 Data (const T& t) : data (t) {}
                 virtual ~Data () {}
-                virtual Envelope* clone () override {return new Data<T> (*this);}
                 T data;
         };
 
-        Envelope* dataptr_ = nullptr;
-        size_t dataTypeHash_ = typeid (void).hash_code ();
+        template <class T>
+        static constexpr bool isLocal ()
+        {
+                return  std::is_trivially_copyable<T>::value && 
+                        (sizeof (T) <= BUTILITIES_ANY_BUFFER_SIZE) && 
+                        (alignof (T) <= alignof (std::max_align_t));
+        }
+
+        union
+        {
+                alignas (std::max_align_t) unsigned char buffer_[BUTILITIES_ANY_BUFFER_SIZE];
+                Envelope* dataptr_ = nullptr;
+        };
+        size_t dataTypeHash_;
+        bool local_ = false;
 
-        Envelope* clone () const
+        template <class T>
+        static size_t typeHash ()
         {
-                if (dataptr_ == nullptr) return nullptr;
-                return dataptr_->clone ();
+                static const size_t hash = typeid (T).hash_code ();
+                return hash;
+        }
+
+        void copy (const Any& that)
+        {
+                if (that.local_) std::copy (that.buffer_, that.buffer_ + BUTILITIES_ANY_BUFFER_SIZE, buffer_);
+                else
+                {
+                        // Content is immutable: Share the envelope
+                        dataptr_ = that.dataptr_;
+                        if (dataptr_) dataptr_->references.fetch_add (1, std::memory_order_relaxed);
+                }
+                dataTypeHash_ = that.dataTypeHash_;
+                local_ = that.local_;
+        }
+
+        void move (Any& that)
+        {
+                if (that.local_) std::copy (that.buffer_, that.buffer_ + BUTILITIES_ANY_BUFFER_SIZE, buffer_);
+                else dataptr_ = that.dataptr_;
+                dataTypeHash_ = that.dataTypeHash_;
+                local_ = that.local_;
+                that.dataptr_ = nullptr;
+                that.dataTypeHash_ = typeHash<void> ();
+                that.local_ = false;
+        }
+
+        void clear ()
+        {
+                if ((!local_) && dataptr_ && (dataptr_->references.fetch_sub (1, std::memory_order_acq_rel) == 1)) delete dataptr_;
+                dataptr_ = nullptr;
+                local_ = false;
         }
 
 public:
@@ -61,16 +119,22 @@ public:
          *  @brief  Constructs an empty Any object.
          * 
          */
-        Any () {}
+        Any () : dataTypeHash_ (typeHash<void> ()) {}
 
         /**
          *  @brief  Constructs a new Any object from another object.
          *  @param that  Other object.
          */
-        Any (const Any& that) : dataTypeHash_ (that.dataTypeHash_)
-        {dataptr_ = that.clone ();}
+        Any (const Any& that) : dataTypeHash_ (that.dataTypeHash_) {copy (that);}
 
-        ~Any () {if (dataptr_) delete dataptr_;}
+        /**
+         *  @brief  Constructs a new Any object by moving the content of 
+         *  another object.
+         *  @param that  Other object. Empty after move.
+         */
+        Any (Any&& that) noexcept : dataTypeHash_ (that.dataTypeHash_) {move (that);}
+
+        ~Any () {clear ();}
 
         /**
          *  @brief  Copy assigns to the content of another object.
@@ -79,9 +143,26 @@ public:
          */
         Any& operator= (const Any& that)
         {
-                if (dataptr_) delete dataptr_;
-                dataptr_ = that.clone ();
-                dataTypeHash_ = that.dataTypeHash_;
+                if (this != &that)
+                {
+                        clear ();
+                        copy (that);
+                }
+                return *this;
+        }
+
+        /**
+         *  @brief  Move assigns the content of another object.
+         *  @param that  Other object. Empty after move.
+         *  @return  Content of this object.
+         */
+        Any& operator= (Any&& that) noexcept
+        {
+                if (this != &that)
+                {
+                        clear ();
+                        move (that);
+                }
                 return *this;
         }
 
@@ -99,22 +180,33 @@ public:
         template <class T> 
         void set (const T& t)
         {
-                if (dataptr_) delete dataptr_;
-                dataptr_ = new Data<T> (t);
-                dataTypeHash_ = typeid (T).hash_code ();
+                clear ();
+                if (isLocal<T> ())
+                {
+                        new (buffer_) T (t);
+                        local_ = true;
+                }
+                else dataptr_ = new Data<T> (t);
+                dataTypeHash_ = typeHash<T> ();
         }
 
         /**
          *  @brief  Gets the content of this Any object.
          *  @tparam T  Data type of the content.
-         *  @return  Containing data or default constructed data object if
-         *  data types don't match.
+         *  @return  Reference to the containing data or to a default 
+         *  constructed data object if data types don't match. Only valid
+         *  until the content of this Any object changes.
          */
         template <class T> 
-        T get () const
+        const T& get () const
         {
-                if ((!dataptr_) || (typeid (T).hash_code () != dataTypeHash_)) return T ();        // Return () better throw exception
-                return ((Data<T>*)dataptr_)->data;
+                if ((typeHash<T> () != dataTypeHash_) || ((!local_) && (!dataptr_)))
+                {
+                        static const T empty = T ();        // Return () better throw exception
+                        return empty;
+                }
+                if (local_) return *std::launder (reinterpret_cast<const T*> (buffer_));
+                return static_cast<const Data<T>*> (dataptr_)->data;
         }
 
 };
@@ -0,0 +1,173 @@
+/* MpscQueue.hpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_MPSCQUEUE_HPP_
+#define BUTILITIES_MPSCQUEUE_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Bounded lock-free multi producer single consumer FIFO queue.
+ *  @tparam T  Trivially copyable data type of the elements.
+ *
+ *  Any number of threads may @c push() elements. Only one thread (the
+ *  consumer) may @c pop() elements. Neither operation locks nor allocates
+ *  memory. The capacity is fixed at construction and rounded up to a power
+ *  of two. @c push() fails if the queue is full.
+ *
+ *  Each slot carries a sequence number telling producers and the consumer
+ *  whether the slot is free or published (D. Vyukov's bounded queue).
+ *
+ *  @c push() is lock-free, but not wait-free: A producer retries if 
+ *  another producer claimed the same slot in the meantime. Thus, a single
+ *  producer may be delayed by other producers, but the system as a whole
+ *  always progresses. @c pop() is wait-free.
+ */
+template <class T>
+class MpscQueue
+{
+	static_assert (std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+
+protected:
+	struct Slot
+	{
+		std::atomic<size_t> sequence;
+		T data;
+	};
+
+	size_t mask_;
+	std::unique_ptr<Slot[]> slots_;
+	alignas (64) std::atomic<size_t> tail_;
+	alignas (64) size_t head_;
+
+public:
+
+	/**
+	 *  @brief  Constructs an empty %MpscQueue.
+	 *  @param capacity  Capacity (rounded up to a power of two).
+	 */
+	explicit MpscQueue (const size_t capacity);
+
+	MpscQueue (const MpscQueue& that) = delete;
+
+	MpscQueue& operator= (const MpscQueue& that) = delete;
+
+	/**
+	 *  @brief  Gets the capacity.
+	 *  @return  Maximum number of elements.
+	 */
+	size_t capacity () const;
+
+	/**
+	 *  @brief  Adds an element to the back. May be called from any thread.
+	 *  @param value  Element.
+	 *  @return  True on success, false if the queue is full.
+	 */
+	bool push (const T& value);
+
+	/**
+	 *  @brief  Removes the front element. Consumer thread only.
+	 *  @param value  Reference to take up the removed element.
+	 *  @return  True on success, false if there is no (completely pushed)
+	 *  element.
+	 */
+	bool pop (T& value);
+
+	/**
+	 *  @brief  Checks if the front element is available. Consumer thread
+	 *  only.
+	 *  @return  True if empty, otherwise false.
+	 */
+	bool empty () const;
+};
+
+template <class T>
+inline MpscQueue<T>::MpscQueue (const size_t capacity) :
+	mask_ (0),
+	slots_ (),
+	tail_ (0),
+	head_ (0)
+{
+	size_t c = 2;
+	while (c < capacity) c <<= 1;
+	mask_ = c - 1;
+	slots_.reset (new Slot[c]);
+	for (size_t i = 0; i < c; ++i) slots_[i].sequence.store (i, std::memory_order_relaxed);
+}
+
+template <class T>
+inline size_t MpscQueue<T>::capacity () const
+{
+	return mask_ + 1;
+}
+
+template <class T>
+inline bool MpscQueue<T>::push (const T& value)
+{
+	size_t pos = tail_.load (std::memory_order_relaxed);
+	while (true)
+	{
+		Slot& slot = slots_[pos & mask_];
+		const size_t seq = slot.sequence.load (std::memory_order_acquire);
+		const std::ptrdiff_t diff = static_cast<std::ptrdiff_t> (seq) - static_cast<std::ptrdiff_t> (pos);
+
+		// Free slot: claim
+		if (diff == 0)
+		{
+			if (tail_.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+			{
+				slot.data = value;
+				slot.sequence.store (pos + 1, std::memory_order_release);
+				return true;
+			}
+		}
+
+		// Not yet consumed: full
+		else if (diff < 0) return false;
+
+		// Claimed by another producer
+		else pos = tail_.load (std::memory_order_relaxed);
+	}
+}
+
+template <class T>
+inline bool MpscQueue<T>::pop (T& value)
+{
+	Slot& slot = slots_[head_ & mask_];
+	if (slot.sequence.load (std::memory_order_acquire) != head_ + 1) return false;
+
+	value = slot.data;
+	slot.sequence.store (head_ + mask_ + 1, std::memory_order_release);
+	++head_;
+	return true;
+}
+
+template <class T>
+inline bool MpscQueue<T>::empty () const
+{
+	return (slots_[head_ & mask_].sequence.load (std::memory_order_acquire) != head_ + 1);
+}
+
+}
+
+#endif /* BUTILITIES_MPSCQUEUE_HPP_ */
@@ -0,0 +1,195 @@
+/* Region.hpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_REGION_HPP_
+#define BUTILITIES_REGION_HPP_
+
+#include <cstddef>
+#include <vector>
+#include "Area.hpp"
+
+#ifndef BUTILITIES_REGION_MAX_AREAS
+#define BUTILITIES_REGION_MAX_AREAS 16
+#endif
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Set of disjoint rectangular areas.
+ *  @tparam T  Data type of the coordinates.
+ *
+ *  A %Region is built by adding areas. Added areas which overlap or touch
+ *  already contained areas are merged to their bounding box. Thus, the
+ *  contained areas never overlap. If the number of areas exceeds the
+ *  maximum size (BUTILITIES_REGION_MAX_AREAS by default), the %Region
+ *  collapses to a single bounding box.
+ */
+template <class T = double>
+class Region
+{
+protected:
+	std::vector<Area<T>> areas_;
+	size_t maxSize_;
+
+public:
+	typedef typename std::vector<Area<T>>::const_iterator const_iterator;
+
+	/**
+	 *  @brief  Constructs an empty %Region.
+	 */
+	Region () : Region (BUTILITIES_REGION_MAX_AREAS) {}
+
+	/**
+	 *  @brief  Constructs an empty %Region.
+	 *  @param maxSize  Maximum number of areas before the %Region collapses
+	 *  to its bounding box.
+	 */
+	explicit Region (const size_t maxSize) :
+		areas_ (),
+		maxSize_ (maxSize > 0 ? maxSize : 1)
+	{}
+
+	/**
+	 *  @brief  Constructs a %Region from an %Area.
+	 *  @param area  %Area.
+	 */
+	Region (const Area<T>& area) : Region () {add (area);}
+
+	/**
+	 *  @brief  Adds an %Area to the %Region.
+	 *  @param area  %Area. Areas without extends are ignored.
+	 */
+	void add (const Area<T>& area)
+	{
+		if ((area.getWidth() <= T()) || (area.getHeight() <= T())) return;
+
+		// Merge overlapping areas until no more overlap
+		Area<T> a = area;
+		bool merged = true;
+		while (merged)
+		{
+			merged = false;
+			for (size_t i = 0; i < areas_.size(); ++i)
+			{
+				if (areas_[i].overlaps (a))
+				{
+					a.extend (areas_[i]);
+					areas_[i] = areas_.back();
+					areas_.pop_back();
+					merged = true;
+					break;
+				}
+			}
+		}
+
+		areas_.push_back (a);
+		if (areas_.size() > maxSize_)
+		{
+			const Area<T> b = getBoundingBox();
+			areas_.clear();
+			areas_.push_back (b);
+		}
+	}
+
+	/**
+	 *  @brief  Adds all areas of another %Region to the %Region.
+	 *  @param region  Other %Region.
+	 */
+	void add (const Region& region)
+	{
+		for (const Area<T>& a : region.areas_) add (a);
+	}
+
+	/**
+	 *  @brief  Removes all areas which are fully included in an %Area.
+	 *  @param area  %Area.
+	 */
+	void remove (const Area<T>& area)
+	{
+		for (size_t i = 0; i < areas_.size(); )
+		{
+			if (area.includes (areas_[i]))
+			{
+				areas_[i] = areas_.back();
+				areas_.pop_back();
+			}
+			else ++i;
+		}
+	}
+
+	/**
+	 *  @brief  Removes all areas.
+	 */
+	void clear () {areas_.clear();}
+
+	/**
+	 *  @brief  Checks if the %Region is empty.
+	 *  @return  True if empty, otherwise false.
+	 */
+	bool empty () const {return areas_.empty();}
+
+	/**
+	 *  @brief  Gets the number of (disjoint) areas.
+	 *  @return  Number of areas.
+	 */
+	size_t size () const {return areas_.size();}
+
+	/**
+	 *  @brief  Gets the bounding box of all areas.
+	 *  @return  Bounding box or an empty %Area if the %Region is empty.
+	 */
+	Area<T> getBoundingBox () const
+	{
+		if (areas_.empty()) return Area<T> ();
+		Area<T> b = areas_.front();
+		for (const Area<T>& a : areas_) b.extend (a);
+		return b;
+	}
+
+	/**
+	 *  @brief  Changes the %Region to its intersection with an %Area.
+	 *  @param area  %Area.
+	 */
+	void intersect (const Area<T>& area)
+	{
+		std::vector<Area<T>> v;
+		v.swap (areas_);
+		for (Area<T> a : v)
+		{
+			a.intersect (area);
+			if ((a.getWidth() > T()) && (a.getHeight() > T())) areas_.push_back (a);
+		}
+	}
+
+	/**
+	 *  @brief  Moves all areas of the %Region.
+	 *  @param offset  Distance to move.
+	 */
+	void moveBy (const Point<T>& offset)
+	{
+		for (Area<T>& a : areas_) a.moveTo (a.getPosition() + offset);
+	}
+
+	const_iterator begin () const {return areas_.cbegin();}
+
+	const_iterator end () const {return areas_.cend();}
+};
+
+}
+
+#endif /* BUTILITIES_REGION_HPP_ */
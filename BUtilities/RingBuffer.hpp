@@ -0,0 +1,241 @@
+/* RingBuffer.hpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_RINGBUFFER_HPP_
+#define BUTILITIES_RINGBUFFER_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Growing FIFO ring buffer.
+ *  @tparam T  Data type of the elements.
+ *
+ *  Elements are added to the back and removed from the front in constant
+ *  time. The buffer capacity is a power of two and doubles if the buffer is
+ *  full. Thus, a %RingBuffer only allocates memory if it grows beyond its
+ *  previous maximum size.
+ */
+template <class T>
+class RingBuffer
+{
+protected:
+	std::vector<T> data_;
+	size_t head_;
+	size_t size_;
+
+public:
+
+	/**
+	 *  @brief  Constructs an empty %RingBuffer.
+	 *  @param capacity  Optional, initial capacity (rounded up to a power
+	 *  of two).
+	 */
+	RingBuffer (const size_t capacity = 16);
+
+	/**
+	 *  @brief  Checks if the %RingBuffer is empty.
+	 *  @return  True if empty, otherwise false.
+	 */
+	bool empty () const;
+
+	/**
+	 *  @brief  Gets the number of elements.
+	 *  @return  Number of elements.
+	 */
+	size_t size () const;
+
+	/**
+	 *  @brief  Gets the number of elements that can be stored without
+	 *  re-allocation.
+	 *  @return  Capacity.
+	 */
+	size_t capacity () const;
+
+	/**
+	 *  @brief  Access to an element.
+	 *  @param i  Position relative to the front element.
+	 *  @return  Reference to the element.
+	 */
+	T& operator[] (const size_t i);
+
+	/**
+	 *  @brief  Access to an element.
+	 *  @param i  Position relative to the front element.
+	 *  @return  Constant reference to the element.
+	 */
+	const T& operator[] (const size_t i) const;
+
+	/**
+	 *  @brief  Access to the front (= oldest) element.
+	 *  @return  Reference to the front element.
+	 */
+	T& front ();
+
+	/**
+	 *  @brief  Access to the back (= latest) element.
+	 *  @return  Reference to the back element.
+	 */
+	T& back ();
+
+	/**
+	 *  @brief  Adds an element to the back. Grows if full.
+	 *  @param value  Element.
+	 */
+	void push_back (const T& value);
+
+	/**
+	 *  @brief  Removes the front element.
+	 */
+	void pop_front ();
+
+	/**
+	 *  @brief  Removes all elements. Keeps the capacity.
+	 */
+	void clear ();
+
+	/**
+	 *  @brief  Removes all elements for which a predicate returns true.
+	 *  @param func  Predicate function.
+	 *  @return  Number of removed elements.
+	 *
+	 *  Keeps the order of the remaining elements. Linear complexity.
+	 */
+	template <class Pred>
+	size_t remove_if (Pred func);
+
+protected:
+	size_t index (const size_t i) const;
+	void grow ();
+};
+
+template <class T>
+inline RingBuffer<T>::RingBuffer (const size_t capacity) :
+	data_ (),
+	head_ (0),
+	size_ (0)
+{
+	size_t c = 1;
+	while (c < capacity) c <<= 1;
+	data_.resize (c);
+}
+
+template <class T>
+inline bool RingBuffer<T>::empty () const
+{
+	return (size_ == 0);
+}
+
+template <class T>
+inline size_t RingBuffer<T>::size () const
+{
+	return size_;
+}
+
+template <class T>
+inline size_t RingBuffer<T>::capacity () const
+{
+	return data_.size();
+}
+
+template <class T>
+inline size_t RingBuffer<T>::index (const size_t i) const
+{
+	return (head_ + i) & (data_.size() - 1);
+}
+
+template <class T>
+inline T& RingBuffer<T>::operator[] (const size_t i)
+{
+	return data_[index (i)];
+}
+
+template <class T>
+inline const T& RingBuffer<T>::operator[] (const size_t i) const
+{
+	return data_[index (i)];
+}
+
+template <class T>
+inline T& RingBuffer<T>::front ()
+{
+	return data_[head_];
+}
+
+template <class T>
+inline T& RingBuffer<T>::back ()
+{
+	return data_[index (size_ - 1)];
+}
+
+template <class T>
+inline void RingBuffer<T>::push_back (const T& value)
+{
+	if (size_ == data_.size()) grow();
+	data_[index (size_)] = value;
+	++size_;
+}
+
+template <class T>
+inline void RingBuffer<T>::pop_front ()
+{
+	if (size_ == 0) return;
+	data_[head_] = T();
+	head_ = index (1);
+	--size_;
+}
+
+template <class T>
+inline void RingBuffer<T>::clear ()
+{
+	while (size_ != 0) pop_front();
+	head_ = 0;
+}
+
+template <class T>
+template <class Pred>
+inline size_t RingBuffer<T>::remove_if (Pred func)
+{
+	size_t n = 0;
+	for (size_t i = 0; i < size_; ++i)
+	{
+		T& e = data_[index (i)];
+		if (func (e)) ++n;
+		else if (n != 0) data_[index (i - n)] = std::move (e);
+	}
+
+	for (size_t i = size_ - n; i < size_; ++i) data_[index (i)] = T();
+	size_ -= n;
+	return n;
+}
+
+template <class T>
+inline void RingBuffer<T>::grow ()
+{
+	std::vector<T> d (data_.size() * 2);
+	for (size_t i = 0; i < size_; ++i) d[i] = std::move (data_[index (i)]);
+	data_.swap (d);
+	head_ = 0;
+}
+
+}
+
+#endif /* BUTILITIES_RINGBUFFER_HPP_ */
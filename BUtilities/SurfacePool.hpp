@@ -0,0 +1,248 @@
+/* SurfacePool.hpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_SURFACEPOOL_HPP_
+#define BUTILITIES_SURFACEPOOL_HPP_
+
+#include <cairo/cairo.h>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <vector>
+#include "cairoplus.h"
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Size-bucketed pool of Cairo image surfaces.
+ *
+ *  Requested surface sizes are rounded up to buckets (see
+ *  @c getBucketSize() ). Thus, acquired surfaces may be larger than
+ *  requested. Released surfaces are kept for re-use by later requests for
+ *  the same bucket until the pool exceeds its maximum size.
+ *
+ *  All methods are thread-safe. Thus, one pool can be shared by the UIs of
+ *  different threads (e. g., plugin UIs in one host process).
+ */
+class SurfacePool
+{
+protected:
+	std::map<std::tuple<int, int, int>, std::vector<cairo_surface_t*>> buckets_;
+	size_t maxBytes_;
+	size_t bytes_;
+	mutable std::mutex mutex_;
+
+public:
+
+	/**
+	 *  @brief  Constructs an empty %SurfacePool.
+	 *  @param maxBytes  Maximum size of all pooled surfaces in bytes.
+	 */
+	explicit SurfacePool (const size_t maxBytes);
+
+	SurfacePool (const SurfacePool& that) = delete;
+
+	SurfacePool& operator= (const SurfacePool& that) = delete;
+
+	/**
+	 *  @brief  Destroys all pooled surfaces.
+	 */
+	~SurfacePool ();
+
+	/**
+	 *  @brief  Rounds a size up to its bucket size.
+	 *  @param size  Size in pixels.
+	 *  @return  Bucket size in pixels.
+	 *
+	 *  Bucket sizes are multiples of 1/8 of the highest power of two not
+	 *  greater than @a size (at least 8). Thus, a bucket exceeds the size
+	 *  by less than 12.5 %.
+	 */
+	static int getBucketSize (const int size);
+
+	/**
+	 *  @brief  Takes a surface out of the pool or creates a new one.
+	 *  @param format  Cairo image format.
+	 *  @param width  Minimum width in pixels.
+	 *  @param height  Minimum height in pixels.
+	 *  @return  Cleared Cairo image surface with bucket size extends and a
+	 *  device scale of 1.0.
+	 */
+	cairo_surface_t* acquire (const cairo_format_t format, const int width, const int height);
+
+	/**
+	 *  @brief  Returns a surface to the pool.
+	 *  @param surface  Cairo image surface.
+	 *
+	 *  The surface is destroyed if it doesn't match a bucket or if the pool
+	 *  would exceed its maximum size.
+	 */
+	void release (cairo_surface_t* surface);
+
+	/**
+	 *  @brief  Destroys all pooled surfaces.
+	 */
+	void clear ();
+
+	/**
+	 *  @brief  Sets the maximum size of all pooled surfaces.
+	 *  @param maxBytes  Maximum size in bytes.
+	 */
+	void setMaxBytes (const size_t maxBytes);
+
+	/**
+	 *  @brief  Gets the maximum size of all pooled surfaces.
+	 *  @return  Maximum size in bytes.
+	 */
+	size_t getMaxBytes () const;
+
+	/**
+	 *  @brief  Gets the size of all pooled surfaces.
+	 *  @return  Size in bytes.
+	 */
+	size_t getBytes () const;
+
+protected:
+	static size_t bytes (cairo_surface_t* surface);
+};
+
+inline SurfacePool::SurfacePool (const size_t maxBytes) :
+	buckets_ (),
+	maxBytes_ (maxBytes),
+	bytes_ (0),
+	mutex_ ()
+{
+
+}
+
+inline SurfacePool::~SurfacePool ()
+{
+	clear ();
+}
+
+inline int SurfacePool::getBucketSize (const int size)
+{
+	if (size <= 8) return 8;
+	int p = 1;
+	while (p <= size / 2) p <<= 1;
+	const int step = (p >= 64 ? p / 8 : 8);
+	return ((size + step - 1) / step) * step;
+}
+
+inline cairo_surface_t* SurfacePool::acquire (const cairo_format_t format, const int width, const int height)
+{
+	const int w = getBucketSize (width);
+	const int h = getBucketSize (height);
+
+	cairo_surface_t* s = nullptr;
+	{
+		std::lock_guard<std::mutex> lock (mutex_);
+		std::map<std::tuple<int, int, int>, std::vector<cairo_surface_t*>>::iterator it = buckets_.find (std::make_tuple (static_cast<int> (format), w, h));
+		if ((it != buckets_.end()) && (!it->second.empty()))
+		{
+			s = it->second.back();
+			it->second.pop_back();
+			bytes_ -= bytes (s);
+		}
+	}
+
+	if (s)
+	{
+		cairo_surface_set_device_scale (s, 1.0, 1.0);
+		cairoplus_surface_clear (s);
+		return s;
+	}
+
+	return cairo_image_surface_create (format, w, h);
+}
+
+inline void SurfacePool::release (cairo_surface_t* surface)
+{
+	if (!surface) return;
+
+	const size_t b = bytes (surface);
+	const int w = cairo_image_surface_get_width (surface);
+	const int h = cairo_image_surface_get_height (surface);
+	if
+	(
+		(cairo_surface_status (surface) == CAIRO_STATUS_SUCCESS) &&
+		(w == getBucketSize (w)) &&
+		(h == getBucketSize (h))
+	)
+	{
+		std::lock_guard<std::mutex> lock (mutex_);
+		if (bytes_ + b <= maxBytes_)
+		{
+			buckets_[std::make_tuple (static_cast<int> (cairo_image_surface_get_format (surface)), w, h)].push_back (surface);
+			bytes_ += b;
+			return;
+		}
+	}
+
+	cairo_surface_destroy (surface);
+}
+
+inline void SurfacePool::clear ()
+{
+	// Destroy outside the lock
+	std::map<std::tuple<int, int, int>, std::vector<cairo_surface_t*>> b;
+	{
+		std::lock_guard<std::mutex> lock (mutex_);
+		b.swap (buckets_);
+		bytes_ = 0;
+	}
+
+	for (std::pair<const std::tuple<int, int, int>, std::vector<cairo_surface_t*>>& v : b)
+	{
+		for (cairo_surface_t* s : v.second) cairo_surface_destroy (s);
+	}
+}
+
+inline void SurfacePool::setMaxBytes (const size_t maxBytes)
+{
+	bool exceeded;
+	{
+		std::lock_guard<std::mutex> lock (mutex_);
+		maxBytes_ = maxBytes;
+		exceeded = (bytes_ > maxBytes_);
+	}
+	if (exceeded) clear ();
+}
+
+inline size_t SurfacePool::getMaxBytes () const
+{
+	std::lock_guard<std::mutex> lock (mutex_);
+	return maxBytes_;
+}
+
+inline size_t SurfacePool::getBytes () const
+{
+	std::lock_guard<std::mutex> lock (mutex_);
+	return bytes_;
+}
+
+inline size_t SurfacePool::bytes (cairo_surface_t* surface)
+{
+	return	static_cast<size_t> (cairo_image_surface_get_stride (surface)) *
+			static_cast<size_t> (cairo_image_surface_get_height (surface));
+}
+
+}
+
+#endif /* BUTILITIES_SURFACEPOOL_HPP_ */
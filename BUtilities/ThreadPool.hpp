@@ -0,0 +1,233 @@
+/* ThreadPool.hpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BUTILITIES_THREADPOOL_HPP_
+#define BUTILITIES_THREADPOOL_HPP_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace BUtilities
+{
+
+/**
+ *  @brief  Work-stealing pool of worker threads for parallel loops.
+ *
+ *  @c parallelFor() distributes the loop indices to one task queue per
+ *  thread (including the calling thread). Each thread takes tasks from the
+ *  front of its own queue. If its queue is empty, it steals tasks from the
+ *  back of the other queues. @c parallelFor() returns if all tasks are
+ *  done.
+ *
+ *  Note: Only one thread may call @c parallelFor() at a time.
+ */
+class ThreadPool
+{
+protected:
+	struct TaskQueue
+	{
+		std::mutex mutex;
+		std::deque<size_t> tasks;
+	};
+
+	std::vector<std::thread> threads_;
+	std::vector<std::unique_ptr<TaskQueue>> queues_;
+	std::mutex mutex_;
+	std::condition_variable start_;
+	std::condition_variable done_;
+	std::function<void (size_t)> func_;
+	size_t generation_;
+	size_t finished_;
+	bool quit_;
+
+public:
+
+	/**
+	 *  @brief  Constructs a %ThreadPool and starts its worker threads.
+	 *  @param threads  Number of worker threads (in addition to the
+	 *  calling thread of @c parallelFor() ).
+	 */
+	explicit ThreadPool (const size_t threads);
+
+	ThreadPool (const ThreadPool& that) = delete;
+
+	ThreadPool& operator= (const ThreadPool& that) = delete;
+
+	/**
+	 *  @brief  Stops and joins all worker threads.
+	 */
+	~ThreadPool ();
+
+	/**
+	 *  @brief  Gets the number of worker threads.
+	 *  @return  Number of worker threads.
+	 */
+	size_t size () const;
+
+	/**
+	 *  @brief  Calls a function for each index in parallel.
+	 *  @param n  Number of indices.
+	 *  @param func  Function to be called for each index from 0 to n - 1.
+	 *
+	 *  Blocks until @a func has been called for all indices. The calling
+	 *  thread takes part in the work.
+	 */
+	void parallelFor (const size_t n, std::function<void (size_t)> func);
+
+protected:
+	void work (const size_t queue);
+
+	bool takeTask (const size_t queue, size_t& task);
+};
+
+inline ThreadPool::ThreadPool (const size_t threads) :
+	threads_ (),
+	queues_ (),
+	mutex_ (),
+	start_ (),
+	done_ (),
+	func_ (),
+	generation_ (0),
+	finished_ (0),
+	quit_ (false)
+{
+	for (size_t i = 0; i <= threads; ++i) queues_.push_back (std::unique_ptr<TaskQueue> (new TaskQueue ()));
+
+	for (size_t i = 0; i < threads; ++i)
+	{
+		threads_.push_back
+		(
+			std::thread
+			(
+				[this, i] ()
+				{
+					size_t generation = 0;
+					while (true)
+					{
+						{
+							std::unique_lock<std::mutex> lock (mutex_);
+							start_.wait (lock, [this, generation] () {return quit_ || (generation_ != generation);});
+							if (quit_) return;
+							generation = generation_;
+						}
+
+						work (i + 1);
+
+						{
+							std::lock_guard<std::mutex> lock (mutex_);
+							++finished_;
+						}
+						done_.notify_all();
+					}
+				}
+			)
+		);
+	}
+}
+
+inline ThreadPool::~ThreadPool ()
+{
+	{
+		std::lock_guard<std::mutex> lock (mutex_);
+		quit_ = true;
+	}
+	start_.notify_all();
+	for (std::thread& t : threads_) t.join();
+}
+
+inline size_t ThreadPool::size () const
+{
+	return threads_.size();
+}
+
+inline void ThreadPool::parallelFor (const size_t n, std::function<void (size_t)> func)
+{
+	if (n == 0) return;
+	if (threads_.empty() || (n == 1))
+	{
+		for (size_t i = 0; i < n; ++i) func (i);
+		return;
+	}
+
+	// Distribute tasks in contiguous blocks. All workers are idle.
+	const size_t nq = queues_.size();
+	for (size_t q = 0; q < nq; ++q)
+	{
+		std::lock_guard<std::mutex> lock (queues_[q]->mutex);
+		for (size_t i = q * n / nq; i < (q + 1) * n / nq; ++i) queues_[q]->tasks.push_back (i);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock (mutex_);
+		func_ = func;
+		finished_ = 0;
+		++generation_;
+	}
+	start_.notify_all();
+
+	work (0);
+
+	// Wait until all workers ran out of tasks
+	std::unique_lock<std::mutex> lock (mutex_);
+	done_.wait (lock, [this] () {return (finished_ == threads_.size());});
+	func_ = nullptr;
+}
+
+inline void ThreadPool::work (const size_t queue)
+{
+	size_t task;
+	while (takeTask (queue, task)) func_ (task);
+}
+
+inline bool ThreadPool::takeTask (const size_t queue, size_t& task)
+{
+	// Own queue: front
+	{
+		std::lock_guard<std::mutex> lock (queues_[queue]->mutex);
+		if (!queues_[queue]->tasks.empty())
+		{
+			task = queues_[queue]->tasks.front();
+			queues_[queue]->tasks.pop_front();
+			return true;
+		}
+	}
+
+	// Other queues: steal from back
+	for (size_t i = 1; i < queues_.size(); ++i)
+	{
+		TaskQueue& q = *queues_[(queue + i) % queues_.size()];
+		std::lock_guard<std::mutex> lock (q.mutex);
+		if (!q.tasks.empty())
+		{
+			task = q.tasks.back();
+			q.tasks.pop_back();
+			return true;
+		}
+	}
+
+	return false;
+}
+
+}
+
+#endif /* BUTILITIES_THREADPOOL_HPP_ */
@@ -16,60 +16,172 @@
  */
 
 #include "Urid.hpp"
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <functional>
 #include <mutex>
 #include <string>
-#include <iostream>
 
 namespace BUtilities 
 {
 
+/*
+ *  Interned URI strings in insert-only hash buckets (URI -> URID) and in a
+ *  dense reverse index (URID -> URI). Entries are never removed. Readers 
+ *  follow atomic pointers without locking. Writers lock the shard of the 
+ *  bucket. The reverse index is split into fixed size chunks. Thus, it 
+ *  grows without moving published entries.
+ */
+struct Urid::UridMap
+{
+    struct Entry
+    {
+        const std::string uri;
+        const uint32_t urid;
+        const Entry* next;
+    };
+
+    static constexpr size_t chunkSize = 1024;
+    static constexpr size_t maxChunks = 4096;
+
+    struct Chunk
+    {
+        std::array<std::atomic<const std::string*>, chunkSize> uris;
+    };
+
+    std::array<std::atomic<const Entry*>, BUTILITIES_URID_BUCKETS> buckets_;
+    std::array<std::mutex, BUTILITIES_URID_SHARDS> shards_;
+    std::array<std::atomic<Chunk*>, maxChunks> chunks_;
+    std::mutex chunkMutex_;
+    std::mutex reservedMutex_;
+    std::atomic<uint32_t> count_;
+
+    UridMap () :
+        buckets_ (),
+        shards_ (),
+        chunks_ (),
+        chunkMutex_ (),
+        reservedMutex_ (),
+        count_ (BUTILITIES_URID_RESERVED_URIDS)
+    {
+        for (std::atomic<const Entry*>& b : buckets_) b.store (nullptr, std::memory_order_relaxed);
+        for (std::atomic<Chunk*>& c : chunks_) c.store (nullptr, std::memory_order_relaxed);
+    }
+
+    static size_t bucket (const std::string& uri)
+    {
+        return std::hash<std::string>() (uri) % BUTILITIES_URID_BUCKETS;
+    }
+
+    const Entry* lookup (const std::string& uri, const size_t b) const
+    {
+        for (const Entry* e = buckets_[b].load (std::memory_order_acquire); e; e = e->next)
+        {
+            if (e->uri == uri) return e;
+        }
+        return nullptr;
+    }
+
+    // Requires the lock of the shard of uri
+    uint32_t insert (const std::string& uri, const size_t b, const uint32_t urid)
+    {
+        const size_t c = urid / chunkSize;
+        if (c >= maxChunks) return BUTILITIES_URID_UNKNOWN_URID;
+
+        Chunk* chunk = chunks_[c].load (std::memory_order_acquire);
+        if (!chunk)
+        {
+            std::lock_guard<std::mutex> lock (chunkMutex_);
+            chunk = chunks_[c].load (std::memory_order_relaxed);
+            if (!chunk)
+            {
+                chunk = new Chunk ();
+                for (std::atomic<const std::string*>& u : chunk->uris) u.store (nullptr, std::memory_order_relaxed);
+                chunks_[c].store (chunk, std::memory_order_release);
+            }
+        }
+
+        // Publish reverse first: URIDs returned by urid() are always
+        // resolvable by uri()
+        const Entry* e = new Entry {uri, urid, buckets_[b].load (std::memory_order_relaxed)};
+        chunk->uris[urid % chunkSize].store (&e->uri, std::memory_order_release);
+        buckets_[b].store (e, std::memory_order_release);
+        return urid;
+    }
+};
+
 uint32_t Urid::add (const std::string& uri)
 {
     UridMap& uridMap = getUridMap ();
-    //mx_.lock();
-    if (uri != "") uridMap.map_[uri] = uridMap.count_;
-    else uridMap.map_[std::string (BUTILITIES_URID_ANONYMOUS_URI) + "_" + std::to_string (uridMap.count_)] = uridMap.count_;
-    //mx_.unlock();
-    return uridMap.count_++;
+
+    // Anonymous: Unique name from the next free URID
+    if (uri == "")
+    {
+        const uint32_t id = uridMap.count_.fetch_add (1, std::memory_order_relaxed);
+        const std::string name = std::string (BUTILITIES_URID_ANONYMOUS_URI) + "_" + std::to_string (id);
+        const size_t b = UridMap::bucket (name);
+        std::lock_guard<std::mutex> lock (uridMap.shards_[b % BUTILITIES_URID_SHARDS]);
+        return uridMap.insert (name, b, id);
+    }
+
+    const size_t b = UridMap::bucket (uri);
+    std::lock_guard<std::mutex> lock (uridMap.shards_[b % BUTILITIES_URID_SHARDS]);
+    const UridMap::Entry* e = uridMap.lookup (uri, b);
+    if (e) return e->urid;
+    return uridMap.insert (uri, b, uridMap.count_.fetch_add (1, std::memory_order_relaxed));
 }
 
-std::string Urid::uri (const uint32_t urid)
+uint32_t Urid::add (const std::string& uri, const uint32_t urid)
 {
+    if ((uri == "") || (urid == BUTILITIES_URID_UNKNOWN_URID) || (urid >= BUTILITIES_URID_RESERVED_URIDS)) return BUTILITIES_URID_UNKNOWN_URID;
+
     UridMap& uridMap = getUridMap ();
-    //mx_.lock();
-    std::string uristr = "";
-    for (std::map<std::string, uint32_t>::const_iterator it = uridMap.map_.begin(); it != uridMap.map_.end(); ++it) 
-    {
-        if (it->second == urid)
-        {
-            uristr = it->first;
-            break;
-        }
-    }
-    //mx_.unlock();
-    return uristr;
+    const size_t b = UridMap::bucket (uri);
+    std::lock_guard<std::mutex> reservedLock (uridMap.reservedMutex_);
+    std::lock_guard<std::mutex> lock (uridMap.shards_[b % BUTILITIES_URID_SHARDS]);
+    const UridMap::Entry* e = uridMap.lookup (uri, b);
+    if (e) return (e->urid == urid ? urid : BUTILITIES_URID_UNKNOWN_URID);
+    if (find (urid)) return BUTILITIES_URID_UNKNOWN_URID;
+    return uridMap.insert (uri, b, urid);
+}
+
+std::string Urid::uri (const uint32_t urid)
+{
+    const std::string* u = find (urid);
+    return (u ? *u : std::string (""));
 }
 
 uint32_t Urid::urid (const std::string& uri)
 {
-    UridMap& uridMap = getUridMap ();
-    //mx_.lock();
-    std::map<std::string, uint32_t>::const_iterator it = uridMap.map_.find (uri);
-    if (it != uridMap.map_.end ()) 
+    if (uri != "")
     {
-        const uint32_t id = it->second;
-        //mx_.unlock();
-        return id;
+        UridMap& uridMap = getUridMap ();
+        const UridMap::Entry* e = uridMap.lookup (uri, UridMap::bucket (uri));
+        if (e) return e->urid;
     }
-    //mx_.unlock();
     return add (uri);
 }
 
+const std::string* Urid::find (const uint32_t urid)
+{
+    UridMap& uridMap = getUridMap ();
+    const size_t c = urid / UridMap::chunkSize;
+    if (c >= UridMap::maxChunks) return nullptr;
+    const UridMap::Chunk* chunk = uridMap.chunks_[c].load (std::memory_order_acquire);
+    return (chunk ? chunk->uris[urid % UridMap::chunkSize].load (std::memory_order_acquire) : nullptr);
+}
+
 Urid::UridMap& Urid::getUridMap ()
 {
-    static UridMap uridMap_ = {{{BUTILITIES_URID_UNKNOWN_URI, BUTILITIES_URID_UNKNOWN_URID}}, 1};
-    return uridMap_;
+    // Never destroyed as static objects may use URIDs upon exit
+    static UridMap* uridMap_ = [] ()
+    {
+        UridMap* m = new UridMap ();
+        m->insert (BUTILITIES_URID_UNKNOWN_URI, UridMap::bucket (BUTILITIES_URID_UNKNOWN_URI), BUTILITIES_URID_UNKNOWN_URID);
+        return m;
+    } ();
+    return *uridMap_;
 }
 
-}
\ No newline at end of file
+}
@@ -19,8 +19,6 @@
 
 #include <cstdint>
 #include <string>
-#include <map>
-#include <mutex>
 
 #ifndef BUTILITIES_URID_URI
 #define BUTILITIES_URID_URI "https://github.com/sjaehn/BWidgets/BUtilities/Urid.hpp"
@@ -34,6 +32,18 @@
 #define BUTILITIES_URID_UNKNOWN_URID 0
 #endif
 
+#ifndef BUTILITIES_URID_RESERVED_URIDS
+#define BUTILITIES_URID_RESERVED_URIDS 64
+#endif
+
+#ifndef BUTILITIES_URID_BUCKETS
+#define BUTILITIES_URID_BUCKETS 4096
+#endif
+
+#ifndef BUTILITIES_URID_SHARDS
+#define BUTILITIES_URID_SHARDS 16
+#endif
+
 #ifndef BUTILITIES_URID_ANONYMOUS_URI
 #define BUTILITIES_URID_ANONYMOUS_URI BUTILITIES_URID_URI "#Anonymous"
 #endif
@@ -56,13 +66,7 @@ namespace BUtilities
 class Urid
 {
 protected:
-    struct UridMap
-    {
-        std::map<std::string, uint32_t> map_;
-        uint32_t count_;
-    };
-    
-    //static std::mutex mx_;
+    struct UridMap;
     
 public:
 
@@ -75,6 +79,21 @@ public:
      */
     static uint32_t add (const std::string& uri);
 
+    /**
+     *  @brief  Adds an URI with a fixed URID.
+     *  @param uri  URI.
+     *  @param urid  Fixed URID below BUTILITIES_URID_RESERVED_URIDS.
+     *  @return  URID, or BUTILITIES_URID_UNKNOWN_URID if @a urid is out of
+     *  the reserved range, or if @a urid or @a uri are already mapped 
+     *  otherwise.
+     *
+     *  URIDs below BUTILITIES_URID_RESERVED_URIDS are reserved for fixed
+     *  URIDs. Fixed URIDs are known at compile time and can be used without
+     *  URI lookup. They have to be added before the URI is converted
+     *  otherwise (e.g., during static initialization).
+     */
+    static uint32_t add (const std::string& uri, const uint32_t urid);
+
     /**
      *  @brief  Converts an URI to an URID.
      *  @param uri  URI.
@@ -83,6 +102,9 @@ public:
      *  Adds the URI if not exists before.
      *  If no URI is provided (uri = ""), then BUTILITIES_URID_ANONYMOUS_URI + "_" and 
      *  the next free URID number is used.
+     *
+     *  Thread-safe. Lookups of existing URIs don't lock. Adding new URIs 
+     *  locks one of BUTILITIES_URID_SHARDS mutexes.
      */
     static uint32_t urid (const std::string& uri);
 
@@ -90,6 +112,8 @@ public:
      *  @brief  Converts an URID to an URI.
      *  @param urid  URID.
      *  @return  URI, or an empty string if the URID didn't exist before.
+     *
+     *  Thread-safe and lock-free. Constant time.
      */
     static std::string uri (const uint32_t urid);
 
@@ -104,6 +128,14 @@ private:
      */
     static UridMap& getUridMap ();
 
+    /**
+     *  @brief  Gets the interned URI string of an URID.
+     *  @param urid  URID.
+     *  @return  Pointer to the URI string or nullptr if the URID doesn't
+     *  exist (yet).
+     */
+    static const std::string* find (const uint32_t urid);
+
 };
 
 }
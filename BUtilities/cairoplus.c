@@ -72,14 +72,22 @@ cairo_surface_t* cairoplus_image_surface_clone_from_image_surface (cairo_surface
 		cairo_format_t format = cairo_image_surface_get_format (sourceSurface);
 		int width = cairo_image_surface_get_width (sourceSurface);
 		int height = cairo_image_surface_get_height (sourceSurface);
+		double xScale = 1.0;
+		double yScale = 1.0;
+		cairo_surface_get_device_scale (sourceSurface, &xScale, &yScale);
 		targetSurface = cairo_image_surface_create (format, width, height);
-		cairo_t* cr = cairo_create (targetSurface);
+		cairo_surface_set_device_scale (targetSurface, xScale, yScale);
 		if (targetSurface && (cairo_surface_status (targetSurface) == CAIRO_STATUS_SUCCESS))
 		{
-			if (cr && (cairo_status (cr) == CAIRO_STATUS_SUCCESS))
+			// Copy pixel data if possible, otherwise paint
+			if (!cairoplus_image_surface_copy_rect (targetSurface, 0, 0, sourceSurface, 0, 0, width, height))
 			{
-				cairo_set_source_surface (cr, sourceSurface, 0, 0);
-				cairo_paint (cr);
+				cairo_t* cr = cairo_create (targetSurface);
+				if (cr && (cairo_status (cr) == CAIRO_STATUS_SUCCESS))
+				{
+					cairo_set_source_surface (cr, sourceSurface, 0, 0);
+					cairo_paint (cr);
+				}
 				cairo_destroy (cr);
 			}
 		}
@@ -90,6 +98,23 @@ cairo_surface_t* cairoplus_image_surface_clone_from_image_surface (cairo_surface
 
 void cairoplus_surface_clear (cairo_surface_t* surface)
 {
+	if 
+	(
+		surface && 
+		(cairo_surface_status (surface) == CAIRO_STATUS_SUCCESS) &&
+		(cairo_surface_get_type (surface) == CAIRO_SURFACE_TYPE_IMAGE)
+	)
+	{
+		cairo_surface_flush (surface);
+		unsigned char* data = cairo_image_surface_get_data (surface);
+		if (data)
+		{
+			memset (data, 0, (size_t) cairo_image_surface_get_stride (surface) * (size_t) cairo_image_surface_get_height (surface));
+			cairo_surface_mark_dirty (surface);
+			return;
+		}
+	}
+
 	cairo_t* cr = cairo_create (surface);
 	if (cr && (cairo_status (cr) == CAIRO_STATUS_SUCCESS))
 	{
@@ -100,6 +125,485 @@ void cairoplus_surface_clear (cairo_surface_t* surface)
 	}
 }
 
+/*
+ * Pixel functions
+ *
+ * Row functions for premultiplied ARGB32 pixels. Scalar versions and SSE2,
+ * AVX2 (x86) or NEON (ARM) versions. The instruction set is selected at
+ * runtime (x86) or at compile time (ARM). Clearing and copying use memset
+ * and memcpy which are already vectorized by the C library.
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)) && defined(__SSE2__)
+#define CAIROPLUS_PIXEL_X86
+#include <immintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define CAIROPLUS_PIXEL_NEON
+#include <arm_neon.h>
+#endif
+
+typedef struct {
+	const char* name;
+	void (*fill_row) (uint32_t* dst, uint32_t pixel, int n);
+	void (*over_row) (uint32_t* dst, const uint32_t* src, int n);
+} cairoplus_pixel_functions;
+
+/* Multiplies each channel by a / 255 (rounded) */
+static inline uint32_t cairoplus_pixel_mul (uint32_t x, uint32_t a)
+{
+	uint32_t rb = (x & 0x00ff00ff) * a + 0x00800080;
+	rb = ((rb + ((rb >> 8) & 0x00ff00ff)) >> 8) & 0x00ff00ff;
+	uint32_t ag = ((x >> 8) & 0x00ff00ff) * a + 0x00800080;
+	ag = (ag + ((ag >> 8) & 0x00ff00ff)) & 0xff00ff00;
+	return rb | ag;
+}
+
+/* Adds each channel with saturation */
+static inline uint32_t cairoplus_pixel_add (uint32_t x, uint32_t y)
+{
+	uint32_t rb = (x & 0x00ff00ff) + (y & 0x00ff00ff);
+	rb = (rb | (0x01000100 - ((rb >> 8) & 0x00010001))) & 0x00ff00ff;
+	uint32_t ag = ((x >> 8) & 0x00ff00ff) + ((y >> 8) & 0x00ff00ff);
+	ag = (ag | (0x01000100 - ((ag >> 8) & 0x00010001))) & 0x00ff00ff;
+	return rb | (ag << 8);
+}
+
+static void cairoplus_fill_row_scalar (uint32_t* dst, uint32_t pixel, int n)
+{
+	for (int i = 0; i < n; ++i) dst[i] = pixel;
+}
+
+static void cairoplus_over_row_scalar (uint32_t* dst, const uint32_t* src, int n)
+{
+	for (int i = 0; i < n; ++i)
+	{
+		const uint32_t s = src[i];
+		const uint32_t a = s >> 24;
+		if (a == 0xff) dst[i] = s;
+		else if (s) dst[i] = cairoplus_pixel_add (s, cairoplus_pixel_mul (dst[i], 0xff - a));
+	}
+}
+
+static const cairoplus_pixel_functions cairoplus_pixel_scalar = {"scalar", cairoplus_fill_row_scalar, cairoplus_over_row_scalar};
+
+#ifdef CAIROPLUS_PIXEL_X86
+
+static void cairoplus_fill_row_sse2 (uint32_t* dst, uint32_t pixel, int n)
+{
+	const __m128i p = _mm_set1_epi32 ((int) pixel);
+	int i = 0;
+	for (; i + 4 <= n; i += 4) _mm_storeu_si128 ((__m128i*) (dst + i), p);
+	cairoplus_fill_row_scalar (dst + i, pixel, n - i);
+}
+
+static void cairoplus_over_row_sse2 (uint32_t* dst, const uint32_t* src, int n)
+{
+	const __m128i zero = _mm_setzero_si128 ();
+	const __m128i ff = _mm_set1_epi32 (0xff);
+	const __m128i half = _mm_set1_epi16 (0x80);
+	const __m128i alpha = _mm_set1_epi32 ((int) 0xff000000);
+	int i = 0;
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128i s = _mm_loadu_si128 ((const __m128i*) (src + i));
+
+		// Skip transparent, copy opaque source pixels
+		if (_mm_movemask_epi8 (_mm_cmpeq_epi32 (s, zero)) == 0xffff) continue;
+		if (_mm_movemask_epi8 (_mm_cmpeq_epi32 (_mm_and_si128 (s, alpha), alpha)) == 0xffff)
+		{
+			_mm_storeu_si128 ((__m128i*) (dst + i), s);
+			continue;
+		}
+
+		// Inverse source alpha for each 16 bit channel
+		__m128i ia = _mm_sub_epi32 (ff, _mm_srli_epi32 (s, 24));
+		ia = _mm_or_si128 (ia, _mm_slli_epi32 (ia, 16));
+		const __m128i ialo = _mm_unpacklo_epi32 (ia, ia);
+		const __m128i iahi = _mm_unpackhi_epi32 (ia, ia);
+
+		// dst * (255 - alpha) / 255 + src
+		const __m128i d = _mm_loadu_si128 ((const __m128i*) (dst + i));
+		__m128i dlo = _mm_add_epi16 (_mm_mullo_epi16 (_mm_unpacklo_epi8 (d, zero), ialo), half);
+		__m128i dhi = _mm_add_epi16 (_mm_mullo_epi16 (_mm_unpackhi_epi8 (d, zero), iahi), half);
+		dlo = _mm_srli_epi16 (_mm_add_epi16 (dlo, _mm_srli_epi16 (dlo, 8)), 8);
+		dhi = _mm_srli_epi16 (_mm_add_epi16 (dhi, _mm_srli_epi16 (dhi, 8)), 8);
+		_mm_storeu_si128 ((__m128i*) (dst + i), _mm_adds_epu8 (_mm_packus_epi16 (dlo, dhi), s));
+	}
+	cairoplus_over_row_scalar (dst + i, src + i, n - i);
+}
+
+static const cairoplus_pixel_functions cairoplus_pixel_sse2 = {"sse2", cairoplus_fill_row_sse2, cairoplus_over_row_sse2};
+
+__attribute__((target("avx2"))) static void cairoplus_fill_row_avx2 (uint32_t* dst, uint32_t pixel, int n)
+{
+	const __m256i p = _mm256_set1_epi32 ((int) pixel);
+	int i = 0;
+	for (; i + 8 <= n; i += 8) _mm256_storeu_si256 ((__m256i*) (dst + i), p);
+	cairoplus_fill_row_scalar (dst + i, pixel, n - i);
+}
+
+__attribute__((target("avx2"))) static void cairoplus_over_row_avx2 (uint32_t* dst, const uint32_t* src, int n)
+{
+	const __m256i zero = _mm256_setzero_si256 ();
+	const __m256i ff = _mm256_set1_epi32 (0xff);
+	const __m256i half = _mm256_set1_epi16 (0x80);
+	const __m256i alpha = _mm256_set1_epi32 ((int) 0xff000000);
+	int i = 0;
+	for (; i + 8 <= n; i += 8)
+	{
+		const __m256i s = _mm256_loadu_si256 ((const __m256i*) (src + i));
+
+		// Skip transparent, copy opaque source pixels
+		if (_mm256_testz_si256 (s, s)) continue;
+		if ((unsigned int) _mm256_movemask_epi8 (_mm256_cmpeq_epi32 (_mm256_and_si256 (s, alpha), alpha)) == 0xffffffffu)
+		{
+			_mm256_storeu_si256 ((__m256i*) (dst + i), s);
+			continue;
+		}
+
+		// Inverse source alpha for each 16 bit channel (unpack and pack 
+		// work within 128 bit lanes)
+		__m256i ia = _mm256_sub_epi32 (ff, _mm256_srli_epi32 (s, 24));
+		ia = _mm256_or_si256 (ia, _mm256_slli_epi32 (ia, 16));
+		const __m256i ialo = _mm256_unpacklo_epi32 (ia, ia);
+		const __m256i iahi = _mm256_unpackhi_epi32 (ia, ia);
+
+		// dst * (255 - alpha) / 255 + src
+		const __m256i d = _mm256_loadu_si256 ((const __m256i*) (dst + i));
+		__m256i dlo = _mm256_add_epi16 (_mm256_mullo_epi16 (_mm256_unpacklo_epi8 (d, zero), ialo), half);
+		__m256i dhi = _mm256_add_epi16 (_mm256_mullo_epi16 (_mm256_unpackhi_epi8 (d, zero), iahi), half);
+		dlo = _mm256_srli_epi16 (_mm256_add_epi16 (dlo, _mm256_srli_epi16 (dlo, 8)), 8);
+		dhi = _mm256_srli_epi16 (_mm256_add_epi16 (dhi, _mm256_srli_epi16 (dhi, 8)), 8);
+		_mm256_storeu_si256 ((__m256i*) (dst + i), _mm256_adds_epu8 (_mm256_packus_epi16 (dlo, dhi), s));
+	}
+	cairoplus_over_row_sse2 (dst + i, src + i, n - i);
+}
+
+static const cairoplus_pixel_functions cairoplus_pixel_avx2 = {"avx2", cairoplus_fill_row_avx2, cairoplus_over_row_avx2};
+
+#endif /* CAIROPLUS_PIXEL_X86 */
+
+#ifdef CAIROPLUS_PIXEL_NEON
+
+static void cairoplus_fill_row_neon (uint32_t* dst, uint32_t pixel, int n)
+{
+	const uint32x4_t p = vdupq_n_u32 (pixel);
+	int i = 0;
+	for (; i + 4 <= n; i += 4) vst1q_u32 (dst + i, p);
+	cairoplus_fill_row_scalar (dst + i, pixel, n - i);
+}
+
+static void cairoplus_over_row_neon (uint32_t* dst, const uint32_t* src, int n)
+{
+	int i = 0;
+	for (; i + 8 <= n; i += 8)
+	{
+		// De-interleaved channels, alpha in val[3]
+		const uint8x8x4_t s = vld4_u8 ((const uint8_t*) (src + i));
+		uint8x8x4_t d = vld4_u8 ((const uint8_t*) (dst + i));
+		const uint8x8_t ia = vmvn_u8 (s.val[3]);
+
+		// dst * (255 - alpha) / 255 + src
+		for (int c = 0; c < 4; ++c)
+		{
+			const uint16x8_t t = vmull_u8 (d.val[c], ia);
+			d.val[c] = vqadd_u8 (vraddhn_u16 (t, vrshrq_n_u16 (t, 8)), s.val[c]);
+		}
+		vst4_u8 ((uint8_t*) (dst + i), d);
+	}
+	cairoplus_over_row_scalar (dst + i, src + i, n - i);
+}
+
+static const cairoplus_pixel_functions cairoplus_pixel_neon = {"neon", cairoplus_fill_row_neon, cairoplus_over_row_neon};
+
+#endif /* CAIROPLUS_PIXEL_NEON */
+
+static const cairoplus_pixel_functions* cairoplus_detect_pixel_functions (void)
+{
+#if defined(CAIROPLUS_PIXEL_X86)
+	__builtin_cpu_init ();
+	return (__builtin_cpu_supports ("avx2") ? &cairoplus_pixel_avx2 : &cairoplus_pixel_sse2);
+#elif defined(CAIROPLUS_PIXEL_NEON)
+	return &cairoplus_pixel_neon;
+#else
+	return &cairoplus_pixel_scalar;
+#endif
+}
+
+/* Selected pixel functions, accessed atomically */
+static const cairoplus_pixel_functions* cairoplus_pixel_functions_selected = NULL;
+
+/* Runtime CPU detection is only done once. Concurrent first calls detect
+ * the same functions. */
+static const cairoplus_pixel_functions* cairoplus_get_pixel_functions (void)
+{
+	const cairoplus_pixel_functions* f = __atomic_load_n (&cairoplus_pixel_functions_selected, __ATOMIC_ACQUIRE);
+	if (f) return f;
+
+	f = cairoplus_detect_pixel_functions ();
+	__atomic_store_n (&cairoplus_pixel_functions_selected, f, __ATOMIC_RELEASE);
+	return f;
+}
+
+const char* cairoplus_pixel_simd (void)
+{
+	return cairoplus_get_pixel_functions ()->name;
+}
+
+int cairoplus_pixel_set_simd (const char* name)
+{
+	const cairoplus_pixel_functions* f = NULL;
+	if (!name) f = cairoplus_detect_pixel_functions ();
+	else if (strcmp (name, "scalar") == 0) f = &cairoplus_pixel_scalar;
+#if defined(CAIROPLUS_PIXEL_X86)
+	else if (strcmp (name, "sse2") == 0) f = &cairoplus_pixel_sse2;
+	else if (strcmp (name, "avx2") == 0)
+	{
+		__builtin_cpu_init ();
+		if (__builtin_cpu_supports ("avx2")) f = &cairoplus_pixel_avx2;
+	}
+#elif defined(CAIROPLUS_PIXEL_NEON)
+	else if (strcmp (name, "neon") == 0) f = &cairoplus_pixel_neon;
+#endif
+
+	if (!f) return 0;
+	__atomic_store_n (&cairoplus_pixel_functions_selected, f, __ATOMIC_RELEASE);
+	return 1;
+}
+
+static int cairoplus_image_surface_get_bytes_per_pixel (cairo_surface_t* surface)
+{
+	if
+	(
+		(!surface) ||
+		(cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS) ||
+		(cairo_surface_get_type (surface) != CAIRO_SURFACE_TYPE_IMAGE)
+	) return 0;
+
+	switch (cairo_image_surface_get_format (surface))
+	{
+		case CAIRO_FORMAT_ARGB32:
+		case CAIRO_FORMAT_RGB24:
+		case CAIRO_FORMAT_RGB30:	return 4;
+		case CAIRO_FORMAT_RGB16_565:	return 2;
+		case CAIRO_FORMAT_A8:		return 1;
+		default:					return 0;
+	}
+}
+
+/* Clips a rectangle to the extends of a surface. Moves the position of a
+ * second rectangle (optional) by the same amount. Returns 0 if empty. */
+static int cairoplus_clip_rect (cairo_surface_t* surface, int* x, int* y, int* width, int* height, int* x2, int* y2)
+{
+	if (*x < 0)
+	{
+		*width += *x;
+		if (x2) *x2 -= *x;
+		*x = 0;
+	}
+	if (*y < 0)
+	{
+		*height += *y;
+		if (y2) *y2 -= *y;
+		*y = 0;
+	}
+	const int w = cairo_image_surface_get_width (surface);
+	const int h = cairo_image_surface_get_height (surface);
+	if (*x + *width > w) *width = w - *x;
+	if (*y + *height > h) *height = h - *y;
+	return (*width > 0) && (*height > 0);
+}
+
+/* Clips a rectangle to the extends of a target and a source surface */
+static int cairoplus_clip_rects (cairo_surface_t* target, int* x, int* y, cairo_surface_t* source, int* sourceX, int* sourceY, int* width, int* height)
+{
+	return	cairoplus_clip_rect (target, x, y, width, height, sourceX, sourceY) &&
+			cairoplus_clip_rect (source, sourceX, sourceY, width, height, x, y);
+}
+
+int cairoplus_image_surface_clear_rect (cairo_surface_t* surface, int x, int y, int width, int height)
+{
+	const int bpp = cairoplus_image_surface_get_bytes_per_pixel (surface);
+	if (!bpp) return 0;
+	if (!cairoplus_clip_rect (surface, &x, &y, &width, &height, NULL, NULL)) return 1;
+
+	cairo_surface_flush (surface);
+	unsigned char* data = cairo_image_surface_get_data (surface);
+	if (!data) return 0;
+	const int stride = cairo_image_surface_get_stride (surface);
+	const size_t size = (size_t) width * (size_t) bpp;
+	for (int j = y; j < y + height; ++j) memset (data + (size_t) j * (size_t) stride + (size_t) x * (size_t) bpp, 0, size);
+	cairo_surface_mark_dirty_rectangle (surface, x, y, width, height);
+	return 1;
+}
+
+int cairoplus_image_surface_fill_rect (cairo_surface_t* surface, int x, int y, int width, int height, uint32_t pixel)
+{
+	if (cairoplus_image_surface_get_bytes_per_pixel (surface) != 4) return 0;
+	const cairo_format_t format = cairo_image_surface_get_format (surface);
+	if ((format != CAIRO_FORMAT_ARGB32) && (format != CAIRO_FORMAT_RGB24)) return 0;
+	if (!cairoplus_clip_rect (surface, &x, &y, &width, &height, NULL, NULL)) return 1;
+
+	cairo_surface_flush (surface);
+	unsigned char* data = cairo_image_surface_get_data (surface);
+	if (!data) return 0;
+	const int stride = cairo_image_surface_get_stride (surface);
+	const cairoplus_pixel_functions* f = cairoplus_get_pixel_functions ();
+	for (int j = y; j < y + height; ++j) f->fill_row ((uint32_t*) (data + (size_t) j * (size_t) stride) + x, pixel, width);
+	cairo_surface_mark_dirty_rectangle (surface, x, y, width, height);
+	return 1;
+}
+
+int cairoplus_image_surface_copy_rect (cairo_surface_t* target, int x, int y, cairo_surface_t* source, int sourceX, int sourceY, int width, int height)
+{
+	const int bpp = cairoplus_image_surface_get_bytes_per_pixel (target);
+	if ((!bpp) || (cairoplus_image_surface_get_bytes_per_pixel (source) != bpp)) return 0;
+	if (cairo_image_surface_get_format (target) != cairo_image_surface_get_format (source)) return 0;
+	if (!cairoplus_clip_rects (target, &x, &y, source, &sourceX, &sourceY, &width, &height)) return 1;
+
+	cairo_surface_flush (source);
+	cairo_surface_flush (target);
+	const unsigned char* src = cairo_image_surface_get_data (source);
+	unsigned char* dst = cairo_image_surface_get_data (target);
+	if ((!src) || (!dst)) return 0;
+	const int sourceStride = cairo_image_surface_get_stride (source);
+	const int targetStride = cairo_image_surface_get_stride (target);
+	const size_t size = (size_t) width * (size_t) bpp;
+	for (int j = 0; j < height; ++j)
+	{
+		memmove
+		(
+			dst + (size_t) (y + j) * (size_t) targetStride + (size_t) x * (size_t) bpp,
+			src + (size_t) (sourceY + j) * (size_t) sourceStride + (size_t) sourceX * (size_t) bpp,
+			size
+		);
+	}
+	cairo_surface_mark_dirty_rectangle (target, x, y, width, height);
+	return 1;
+}
+
+int cairoplus_image_surface_over_rect (cairo_surface_t* target, int x, int y, cairo_surface_t* source, int sourceX, int sourceY, int width, int height)
+{
+	if ((cairoplus_image_surface_get_bytes_per_pixel (target) != 4) || (cairoplus_image_surface_get_bytes_per_pixel (source) != 4)) return 0;
+	const cairo_format_t targetFormat = cairo_image_surface_get_format (target);
+	const cairo_format_t sourceFormat = cairo_image_surface_get_format (source);
+	if ((targetFormat != CAIRO_FORMAT_ARGB32) && (targetFormat != CAIRO_FORMAT_RGB24)) return 0;
+	if ((sourceFormat != CAIRO_FORMAT_ARGB32) && (sourceFormat != CAIRO_FORMAT_RGB24)) return 0;
+	if (!cairoplus_clip_rects (target, &x, &y, source, &sourceX, &sourceY, &width, &height)) return 1;
+
+	cairo_surface_flush (source);
+	cairo_surface_flush (target);
+	const unsigned char* src = cairo_image_surface_get_data (source);
+	unsigned char* dst = cairo_image_surface_get_data (target);
+	if ((!src) || (!dst)) return 0;
+	const int sourceStride = cairo_image_surface_get_stride (source);
+	const int targetStride = cairo_image_surface_get_stride (target);
+	const cairoplus_pixel_functions* f = cairoplus_get_pixel_functions ();
+	for (int j = 0; j < height; ++j)
+	{
+		uint32_t* d = (uint32_t*) (dst + (size_t) (y + j) * (size_t) targetStride) + x;
+		const uint32_t* s = (const uint32_t*) (src + (size_t) (sourceY + j) * (size_t) sourceStride) + sourceX;
+
+		// RGB24 sources are opaque, their upper byte is undefined
+		if (sourceFormat == CAIRO_FORMAT_RGB24) for (int i = 0; i < width; ++i) d[i] = s[i] | 0xff000000;
+		else f->over_row (d, s, width);
+	}
+	cairo_surface_mark_dirty_rectangle (target, x, y, width, height);
+	return 1;
+}
+
+/* Converts a user space coordinate into a device pixel coordinate. Returns 0
+ * if it doesn't hit a full pixel. */
+static int cairoplus_to_pixel (double value, double scale, double offset, int* pixel)
+{
+	const double v = value * scale + offset;
+	const double r = (v < 0.0 ? v - 0.5 : v + 0.5);
+	if ((r < -2147483647.0) || (r > 2147483647.0)) return 0;
+	*pixel = (int) r;
+	const double e = v - (double) *pixel;
+	return FABS (e) < 0.0001;
+}
+
+/* Converts a user space area into device pixels. Returns 0 if it doesn't
+ * match full pixels. */
+static int cairoplus_area_to_pixels (cairo_surface_t* surface, double x, double y, double width, double height, int* x0, int* y0, int* x1, int* y1)
+{
+	double xScale = 1.0;
+	double yScale = 1.0;
+	double xOffset = 0.0;
+	double yOffset = 0.0;
+	cairo_surface_get_device_scale (surface, &xScale, &yScale);
+	cairo_surface_get_device_offset (surface, &xOffset, &yOffset);
+	return	cairoplus_to_pixel (x, xScale, xOffset, x0) &&
+			cairoplus_to_pixel (y, yScale, yOffset, y0) &&
+			cairoplus_to_pixel (x + width, xScale, xOffset, x1) &&
+			cairoplus_to_pixel (y + height, yScale, yOffset, y1);
+}
+
+uint32_t cairoplus_pixel_from_rgba (double red, double green, double blue, double alpha)
+{
+	// Same conversion as Cairo (via 16 bit) and pixman
+	const double a = (alpha < 0.0 ? 0.0 : (alpha > 1.0 ? 1.0 : alpha));
+	const double c[3] = {blue, green, red};
+	uint32_t pixel = ((uint32_t) (a * 65535.0 + 0.5) >> 8) << 24;
+	for (int i = 0; i < 3; ++i)
+	{
+		const double v = (c[i] < 0.0 ? 0.0 : (c[i] > 1.0 ? 1.0 : c[i]));
+		pixel |= ((uint32_t) (v * a * 65535.0 + 0.5) >> 8) << (8 * i);
+	}
+	return pixel;
+}
+
+int cairoplus_surface_area_is_pixel_aligned (cairo_surface_t* surface, double x, double y, double width, double height)
+{
+	int x0, y0, x1, y1;
+	return	cairoplus_image_surface_get_bytes_per_pixel (surface) &&
+			cairoplus_area_to_pixels (surface, x, y, width, height, &x0, &y0, &x1, &y1);
+}
+
+int cairoplus_surface_clear_area (cairo_surface_t* surface, double x, double y, double width, double height)
+{
+	int x0, y0, x1, y1;
+	if (!cairoplus_image_surface_get_bytes_per_pixel (surface)) return 0;
+	if (!cairoplus_area_to_pixels (surface, x, y, width, height, &x0, &y0, &x1, &y1)) return 0;
+	return cairoplus_image_surface_clear_rect (surface, x0, y0, x1 - x0, y1 - y0);
+}
+
+int cairoplus_surface_fill_area (cairo_surface_t* surface, double x, double y, double width, double height, uint32_t pixel)
+{
+	int x0, y0, x1, y1;
+	if (cairoplus_image_surface_get_bytes_per_pixel (surface) != 4) return 0;
+	if (!cairoplus_area_to_pixels (surface, x, y, width, height, &x0, &y0, &x1, &y1)) return 0;
+	return cairoplus_image_surface_fill_rect (surface, x0, y0, x1 - x0, y1 - y0, pixel);
+}
+
+int cairoplus_surface_paint_area (cairo_surface_t* target, double x, double y, double width, double height, cairo_surface_t* source, double sourceX, double sourceY)
+{
+	if ((!cairoplus_image_surface_get_bytes_per_pixel (target)) || (!cairoplus_image_surface_get_bytes_per_pixel (source))) return 0;
+
+	double xScale = 1.0;
+	double yScale = 1.0;
+	double sourceXScale = 1.0;
+	double sourceYScale = 1.0;
+	double sourceXOffset = 0.0;
+	double sourceYOffset = 0.0;
+	cairo_surface_get_device_scale (target, &xScale, &yScale);
+	cairo_surface_get_device_scale (source, &sourceXScale, &sourceYScale);
+	cairo_surface_get_device_offset (source, &sourceXOffset, &sourceYOffset);
+	if ((xScale != sourceXScale) || (yScale != sourceYScale)) return 0;
+
+	int x0, y0, x1, y1, sx, sy;
+	if
+	(
+		(!cairoplus_area_to_pixels (target, x, y, width, height, &x0, &y0, &x1, &y1)) ||
+		(!cairoplus_to_pixel (x - sourceX, xScale, sourceXOffset, &sx)) ||
+		(!cairoplus_to_pixel (y - sourceY, yScale, sourceYOffset, &sy))
+	) return 0;
+
+	// Cairo doesn't paint outside the source surface (CAIRO_EXTEND_NONE)
+	return cairoplus_image_surface_over_rect (target, x0, y0, source, sx, sy, x1 - x0, y1 - y0);
+}
+
 char cairo_nil_text[1] = "";
 
 char* cairoplus_create_text_fitted (cairo_t* cr, double width, cairoplus_text_decorations decorations, char* text)
@@ -57,7 +57,7 @@ void cairoplus_rectangle_rounded (cairo_t* cr, double x, double y, double width,
 
 /**
  *  @brief  Creates a new Cairo image surface and copies the content from a 
- *  source Cairo image surface.
+ *  source Cairo image surface. Also copies the device scale.
  *  @param sourceSurface  Source Cairo (image) surface.
  *  @return  Created new Cairo image surface.
  */
@@ -69,6 +69,170 @@ cairo_surface_t* cairoplus_image_surface_clone_from_image_surface (cairo_surface
  */
 void cairoplus_surface_clear (cairo_surface_t* surface);
 
+/**
+ *  @brief  Gets the name of the instruction set used by the cairoplus pixel
+ *  functions.
+ *  @return  "avx2", "sse2", "neon" or "scalar". Selected at runtime.
+ */
+const char* cairoplus_pixel_simd (void);
+
+/**
+ *  @brief  Selects the instruction set used by the cairoplus pixel 
+ *  functions (e.g., for tests and benchmarks).
+ *  @param name  "avx2", "sse2", "neon", "scalar" or NULL for the runtime 
+ *  selection.
+ *  @return  1 on success, 0 if the instruction set is not supported.
+ *
+ *  Not to be called while other threads use the pixel functions.
+ */
+int cairoplus_pixel_set_simd (const char* name);
+
+/**
+ *  @brief  Clears a rectangle of a Cairo image surface by directly writing
+ *  to the pixel data.
+ *  @param surface  Cairo image surface.
+ *  @param x  X coordinate in pixels.
+ *  @param y  Y coordinate in pixels.
+ *  @param width  Width in pixels.
+ *  @param height  Height in pixels.
+ *  @return  1 on success, 0 if the surface is not supported (no image
+ *  surface or sub-byte pixel format).
+ *
+ *  The rectangle is clipped to the surface. The device scale and offset are
+ *  ignored.
+ */
+int cairoplus_image_surface_clear_rect (cairo_surface_t* surface, int x, int y, int width, int height);
+
+/**
+ *  @brief  Fills a rectangle of a Cairo image surface with a solid pixel
+ *  value by directly writing to the pixel data.
+ *  @param surface  Cairo image surface (ARGB32 or RGB24).
+ *  @param x  X coordinate in pixels.
+ *  @param y  Y coordinate in pixels.
+ *  @param width  Width in pixels.
+ *  @param height  Height in pixels.
+ *  @param pixel  Premultiplied ARGB32 pixel value.
+ *  @return  1 on success, 0 if the surface is not supported.
+ *
+ *  The rectangle is clipped to the surface. The device scale and offset are
+ *  ignored.
+ */
+int cairoplus_image_surface_fill_rect (cairo_surface_t* surface, int x, int y, int width, int height, uint32_t pixel);
+
+/**
+ *  @brief  Copies a rectangle from a source Cairo image surface to a target
+ *  Cairo image surface of the same format.
+ *  @param target  Target Cairo image surface.
+ *  @param x  Target X coordinate in pixels.
+ *  @param y  Target Y coordinate in pixels.
+ *  @param source  Source Cairo image surface.
+ *  @param sourceX  Source X coordinate in pixels.
+ *  @param sourceY  Source Y coordinate in pixels.
+ *  @param width  Width in pixels.
+ *  @param height  Height in pixels.
+ *  @return  1 on success, 0 if the surfaces are not supported.
+ *
+ *  The rectangle is clipped to both surfaces. The device scale and offset
+ *  are ignored.
+ */
+int cairoplus_image_surface_copy_rect (cairo_surface_t* target, int x, int y, cairo_surface_t* source, int sourceX, int sourceY, int width, int height);
+
+/**
+ *  @brief  Composes a rectangle from a source Cairo image surface over a
+ *  target Cairo image surface (CAIRO_OPERATOR_OVER).
+ *  @param target  Target Cairo image surface (ARGB32 or RGB24).
+ *  @param x  Target X coordinate in pixels.
+ *  @param y  Target Y coordinate in pixels.
+ *  @param source  Source Cairo image surface (ARGB32 or RGB24).
+ *  @param sourceX  Source X coordinate in pixels.
+ *  @param sourceY  Source Y coordinate in pixels.
+ *  @param width  Width in pixels.
+ *  @param height  Height in pixels.
+ *  @return  1 on success, 0 if the surfaces are not supported.
+ *
+ *  The rectangle is clipped to both surfaces. The device scale and offset
+ *  are ignored.
+ */
+int cairoplus_image_surface_over_rect (cairo_surface_t* target, int x, int y, cairo_surface_t* source, int sourceX, int sourceY, int width, int height);
+
+/**
+ *  @brief  Converts a color into a premultiplied ARGB32 pixel value the same
+ *  way Cairo does.
+ *  @param red  Red [0, 1].
+ *  @param green  Green [0, 1].
+ *  @param blue  Blue [0, 1].
+ *  @param alpha  Alpha [0, 1].
+ *  @return  Premultiplied ARGB32 pixel value.
+ */
+uint32_t cairoplus_pixel_from_rgba (double red, double green, double blue, double alpha);
+
+/**
+ *  @brief  Tests if an area of a Cairo image surface matches full device
+ *  pixels.
+ *  @param surface  Cairo surface.
+ *  @param x  X coordinate in user space.
+ *  @param y  Y coordinate in user space.
+ *  @param width  Width in user space.
+ *  @param height  Height in user space.
+ *  @return  1 if @a surface is a supported image surface and the area 
+ *  matches full device pixels, otherwise 0.
+ */
+int cairoplus_surface_area_is_pixel_aligned (cairo_surface_t* surface, double x, double y, double width, double height);
+
+/**
+ *  @brief  Clears an area of a Cairo image surface if the area matches full
+ *  device pixels.
+ *  @param surface  Cairo surface.
+ *  @param x  X coordinate in user space.
+ *  @param y  Y coordinate in user space.
+ *  @param width  Width in user space.
+ *  @param height  Height in user space.
+ *  @return  1 on success, 0 if the surface is not supported or the area
+ *  doesn't match full device pixels. Use Cairo instead.
+ *
+ *  User space is defined by the device scale and offset of @a surface.
+ */
+int cairoplus_surface_clear_area (cairo_surface_t* surface, double x, double y, double width, double height);
+
+/**
+ *  @brief  Fills an area of a Cairo image surface with a solid pixel value
+ *  if the area matches full device pixels.
+ *  @param surface  Cairo surface (ARGB32 or RGB24).
+ *  @param x  X coordinate in user space.
+ *  @param y  Y coordinate in user space.
+ *  @param width  Width in user space.
+ *  @param height  Height in user space.
+ *  @param pixel  Premultiplied ARGB32 pixel value (see 
+ *  @c cairoplus_pixel_from_rgba() ).
+ *  @return  1 on success, 0 if the surface is not supported or the area 
+ *  doesn't match full device pixels. Use Cairo instead.
+ *
+ *  Replaces the pixels (CAIRO_OPERATOR_SOURCE). This equals the default 
+ *  operator on cleared areas and for opaque colors.
+ */
+int cairoplus_surface_fill_area (cairo_surface_t* surface, double x, double y, double width, double height, uint32_t pixel);
+
+/**
+ *  @brief  Paints an area of a source Cairo image surface over a target
+ *  Cairo image surface if the area matches full device pixels.
+ *  @param target  Target Cairo surface.
+ *  @param x  X coordinate in target user space.
+ *  @param y  Y coordinate in target user space.
+ *  @param width  Width in target user space.
+ *  @param height  Height in target user space.
+ *  @param source  Source Cairo surface.
+ *  @param sourceX  X coordinate of the source origin in target user space.
+ *  @param sourceY  Y coordinate of the source origin in target user space.
+ *  @return  1 on success, 0 if the surfaces are not supported, differ in
+ *  their device scales, or the area doesn't match full device pixels. Use
+ *  Cairo instead.
+ *
+ *  Equivalent to cairo_set_source_surface (cr, source, sourceX, sourceY),
+ *  cairo_rectangle (cr, x, y, width, height) and cairo_fill (cr) with the
+ *  default operator.
+ */
+int cairoplus_surface_paint_area (cairo_surface_t* target, double x, double y, double width, double height, cairo_surface_t* source, double sourceX, double sourceY);
+
 /**
  *  @brief  Splits off a text that fits within an output area defined by its 
  *  width.
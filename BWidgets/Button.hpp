@@ -272,9 +272,10 @@ inline void Button::enter ()
 		Linkable* m = w->getMain();
 		if (!m) return;
 		EventQueueable* q = dynamic_cast<EventQueueable*>(m);
+		if (!q) return;
 
 		// Press
-		BEvents::PointerEvent* press = new BEvents::PointerEvent
+		BEvents::PointerEvent* press = q->createEvent<BEvents::PointerEvent>
 									(
 											w,
 											BEvents::Event::EventType::buttonPressEvent,
@@ -286,7 +287,7 @@ inline void Button::enter ()
 		q->addEventToQueue (press);
 
 		// Release
-		BEvents::PointerEvent* release = new BEvents::PointerEvent
+		BEvents::PointerEvent* release = q->createEvent<BEvents::PointerEvent>
 										(
 											w,
 											BEvents::Event::EventType::buttonReleaseEvent,
@@ -298,7 +299,7 @@ inline void Button::enter ()
 		q->addEventToQueue (release);
 
 		// Click
-		BEvents::PointerEvent* click = new BEvents::PointerEvent
+		BEvents::PointerEvent* click = q->createEvent<BEvents::PointerEvent>
 										(
 											w,
 											BEvents::Event::EventType::buttonClickEvent,
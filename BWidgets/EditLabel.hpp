@@ -565,9 +565,7 @@ inline size_t EditLabel::getCursorFromCoords (const BUtilities::Point<>& positio
 	const std::u32string u32labelText = convert.from_bytes (text_);
 	size_t cursor = u32labelText.length ();
 
-	if ((!cairoSurface()) || (cairo_surface_status (cairoSurface()) != CAIRO_STATUS_SUCCESS)) return 0;
-
-	cairo_t* cr = cairo_create (cairoSurface());
+	cairo_t* cr = cairo_create (getScratchSurface());
 
 	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
 	{
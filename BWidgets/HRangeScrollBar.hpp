@@ -65,9 +65,50 @@ protected:
 	bool fineTuned_;
 
 public:
+	/**
+	 *  @brief  Draggable %Frame with a knob. Used as range limit button.
+	 */
+	class KnobFrame : public Frame
+	{
+	public:
+		/**
+		 *  @brief  Constructs a default %KnobFrame object.
+		 *  @param URID  URID.
+		 *  @param title  %Widget title.
+		 */
+		KnobFrame (const uint32_t urid, const std::string& title);
+
+		/**
+		 *  @brief  Creates a clone of the %KnobFrame. 
+		 *  @return  Pointer to the new %KnobFrame.
+		 */
+		virtual Widget* clone () const override;
+
+	protected:
+		/**
+		 *  @brief  Unclipped draw a %KnobFrame to the surface.
+		 */
+		virtual void draw () override;
+
+		/**
+		 *  @brief  Clipped draw a %KnobFrame to the surface.
+		 *  @param x0  X origin of the clipped area. 
+		 *  @param y0  Y origin of the clipped area. 
+		 *  @param width  Width of the clipped area.
+		 *  @param height  Height of the clipped area. 
+		 */
+		virtual void draw (const double x0, const double y0, const double width, const double height) override;
+
+		/**
+		 *  @brief  Clipped draw a %KnobFrame to the surface.
+		 *  @param area  Clipped area. 
+		 */
+		virtual void draw (const BUtilities::Area<>& area) override;
+	};
+
 	HScrollBar scrollbar;
-	Frame button1;
-	Frame button2;
+	KnobFrame button1;
+	KnobFrame button2;
 	Symbol symbol1;
 	Symbol symbol2;
 
@@ -433,6 +474,57 @@ inline HRangeScrollBar::HRangeScrollBar	(const double  x, const double y, const
 	add (&button2);
 }
 
+inline HRangeScrollBar::KnobFrame::KnobFrame (const uint32_t urid, const std::string& title) :
+	Frame (urid, title)
+{
+
+}
+
+inline Widget* HRangeScrollBar::KnobFrame::clone () const 
+{
+	Widget* f = new KnobFrame (urid_, title_);
+	f->copy (this);
+	return f;
+}
+
+inline void HRangeScrollBar::KnobFrame::draw ()
+{
+	draw (0, 0, getWidth(), getHeight());
+}
+
+inline void HRangeScrollBar::KnobFrame::draw (const double x0, const double y0, const double width, const double height)
+{
+	draw (BUtilities::Area<> (x0, y0, width, height));
+}
+
+inline void HRangeScrollBar::KnobFrame::draw (const BUtilities::Area<>& area)
+{
+	if ((!cairoSurface()) || (cairo_surface_status (cairoSurface()) != CAIRO_STATUS_SUCCESS)) return;
+
+	// Draw super class widget elements first
+	Frame::draw (area);
+
+	const double h = getHeight ();
+
+	// Draw knob
+	// only if minimum requirements satisfied
+	if (h >= 1.0)
+	{
+		cairo_t* cr = cairo_create (cairoSurface());
+
+		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+		{
+			// Limit cairo-drawing area
+			cairo_rectangle (cr, area.getX (), area.getY (), area.getWidth (), area.getHeight ());
+			cairo_clip (cr);
+
+			drawKnob (cr, 0.5 * h, 0.5 * h, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_REL_SIZE * h, 0.0, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_COLOR, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_COLOR);
+		}
+
+		cairo_destroy (cr);
+	}
+}
+
 inline Widget* HRangeScrollBar::clone () const 
 {
 	Widget* f = new HRangeScrollBar (urid_, title_);
@@ -516,13 +608,6 @@ inline void HRangeScrollBar::update ()
 
 		button2.moveTo (x + (w - h) * (step_.second >= 0.0 ? rv.second : 1.0 - rv.second), y);
 		button2.resize (h, h);
-
-		cairo_t* cr1 = cairo_create (button1.cairoSurface());
-		drawKnob (cr1, 0.5 * h, 0.5 * h, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_REL_SIZE * h, 0.0, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_COLOR, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_COLOR);
-		cairo_destroy (cr1);
-		cairo_t* cr2 = cairo_create (button2.cairoSurface());
-		drawKnob (cr2, 0.5 * h, 0.5 * h, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_REL_SIZE * h, 0.0, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_COLOR, BWIDGETS_DEFAULT_SCROLLBAR_KNOB_COLOR);
-		cairo_destroy (cr2);
 	}
 
 	Widget::update();
@@ -116,6 +116,17 @@ public:
      */
     virtual void update () override;
 
+	/**
+	 *  @brief  Gets the area of the %HSlider which depends on a state 
+	 *  property.
+	 *  @param dependency  State property (value, status, or text).
+	 *  @return  Area relative to the %HSlider origin.
+	 *
+	 *  The value dependent area is the knob area (and the adjacent bar). 
+	 *  Thus, a value change only redraws the knob sweep.
+	 */
+	virtual BUtilities::Area<> getDependentArea (const DrawDependency dependency) const override;
+
 protected:
 	/**
      *  @brief  Unclipped draw a %HSlider to the surface.
@@ -199,6 +210,18 @@ inline void HSlider::update ()
 	Widget::update();
 }
 
+inline BUtilities::Area<> HSlider::getDependentArea (const DrawDependency dependency) const
+{
+	if (dependency == DrawDependency::layout) return scale_;
+	if (dependency != DrawDependency::value) return HScale::getDependentArea (dependency);
+
+	const double rval = getRatioFromValue (getValue());
+	const double x = scale_.getX() + (step_ >= 0.0 ? rval : 1.0 - rval) * scale_.getWidth();
+	const double r =	std::max (0.5 * (BWIDGETS_DEFAULT_SLIDER_KNOB_REL_SIZE / BWIDGETS_DEFAULT_SLIDER_BAR_REL_SIZE) * (scale_.getHeight() - 1.0), 0.5 * scale_.getHeight()) + 
+						2.0;
+	return BUtilities::Area<> (x - r, 0.0, 2.0 * r, getHeight());
+}
+
 inline void HSlider::draw ()
 {
 	draw (0, 0, getWidth(), getHeight());
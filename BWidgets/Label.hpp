@@ -250,8 +250,9 @@ inline void Label::setText (const std::string& text)
 {
 	if (text != text_)
 	{
+		const BUtilities::Area<> a0 = getDependentArea (DrawDependency::text);
 		text_ = text;
-		update ();
+		updateArea (DrawDependency::text, a0);
 	}
 }
 
@@ -262,7 +263,7 @@ inline std::string Label::getText () const
 
 inline BUtilities::Point<> Label::getTextExtends (std::string& text) const
 {
-	cairo_t* cr = cairo_create (cairoSurface());
+	cairo_t* cr = cairo_create (getScratchSurface());
 	cairo_text_extents_t ext = getFont().getCairoTextExtents(cr, text.c_str ());
 	cairo_destroy (cr);
 	return BUtilities::Point<> (ext.width, ext.height);
@@ -290,7 +291,7 @@ inline double Label::getWidth () const
 
 inline double Label::getWidth (const std::string& text) const
 {
-	return getExtends(text).y;
+	return getExtends(text).x;
 }
 
 inline double Label::getHeight () const
@@ -311,7 +312,7 @@ inline BUtilities::Point<> Label::getExtends () const
 inline BUtilities::Point<> Label::getExtends (const std::string& text) const
 {
 	// Get label text size
-	cairo_t* cr = cairo_create (cairoSurface());
+	cairo_t* cr = cairo_create (getScratchSurface());
 	BStyles::Font font = getFont();
 	cairo_text_extents_t ext = font.getCairoTextExtents(cr, text.c_str ());
 	double w = ext.width;
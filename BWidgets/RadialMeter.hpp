@@ -36,10 +36,6 @@
 #define BWIDGETS_DEFAULT_RADIALMETER_HEIGHT 40.0
 #endif
 
-#ifndef BSTYLES_STYLEPROPERTY_HICOLORS_URI
-#define BSTYLES_STYLEPROPERTY_HICOLORS_URI BSTYLES_STYLEPROPERTY_URI "#HiColors"
-#endif
-
 namespace BWidgets
 {
 
@@ -307,14 +303,15 @@ inline void RadialMeter::update ()
 
 inline BStyles::ColorMap RadialMeter::getHiColors() const
 {
-    BStyles::Style::const_iterator it = style_.find (BUtilities::Urid::urid (BSTYLES_STYLEPROPERTY_HICOLORS_URI));
-    if ((it == style_.end()) || style_.isStyle (it)) return getFgColors();
+    const BStyles::Style& style = getStyle();
+    BStyles::Style::const_iterator it = style.find (BSTYLES_STYLEPROPERTY_HICOLORS_URID);
+    if ((it == style.end()) || style.isStyle (it)) return getFgColors();
     else return it->second.get<BStyles::ColorMap>();
 }
 
 inline void RadialMeter::setHiColors (const BStyles::ColorMap& colors)
 {
-    style_[BUtilities::Urid::urid (BSTYLES_STYLEPROPERTY_HICOLORS_URI)] = BUtilities::makeAny<BStyles::ColorMap> (colors);
+    getMutableStyle()[BSTYLES_STYLEPROPERTY_HICOLORS_URID] = BUtilities::makeAny<BStyles::ColorMap> (colors);
 }
 
 inline void RadialMeter::draw ()
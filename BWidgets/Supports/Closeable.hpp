@@ -102,9 +102,8 @@ inline void Closeable::postCloseRequest (Widget* handle)
     Widget* thisWidget = dynamic_cast<Widget*> (this);
 	if (thisWidget && handle)
 	{
-		BEvents::WidgetEvent* event = new BEvents::WidgetEvent (handle, thisWidget, BEvents::Event::EventType::closeRequestEvent);
         EventQueueable* q = dynamic_cast<EventQueueable*>(thisWidget->getMain());
-		if (q && event) q->addEventToQueue (event);
+		if (q) q->addEventToQueue (q->createEvent<BEvents::WidgetEvent> (handle, thisWidget, BEvents::Event::EventType::closeRequestEvent));
 	}
 }
 
@@ -18,9 +18,13 @@
 #ifndef BWIDGETS_EVENTQUEUEABLE_HPP_
 #define BWIDGETS_EVENTQUEUEABLE_HPP_
 
-#include <algorithm>
-#include <list>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
 #include "../../BEvents/Event.hpp"
+#include "../../BEvents/EventPool.hpp"
+#include "../../BUtilities/RingBuffer.hpp"
 
 namespace BWidgets
 {
@@ -30,13 +34,46 @@ namespace BWidgets
  *
  *  Parent class of the (main) BWidgets::Window event queue. By default, all
  *  events are able to be queued to the event queue.
+ *
+ *  %EventQueueable also owns an event pool. Events created by 
+ *  @c createEvent() are recycled instead of being deleted once their 
+ *  lifetime ends.
+ *
+ *  The event queue is a ring buffer. The latest queued event for each 
+ *  combination of widget and event type is indexed and can be accessed in
+ *  constant time (see @c getQueuedEvent() ), e. g. for event merging.
+ *  Events are also popped from any position of the event queue in constant
+ *  time. The popped event leaves an empty (nullptr) slot which is skipped
+ *  by @c popEvent() .
  */
 class EventQueueable
 {
 
 protected:
+    struct EventKey
+    {
+        const Widget* widget;
+        BEvents::Event::EventType eventType;
+
+        bool operator== (const EventKey& that) const
+        {
+            return (widget == that.widget) && (eventType == that.eventType);
+        }
+    };
+
+    struct EventKeyHash
+    {
+        size_t operator() (const EventKey& key) const
+        {
+            return std::hash<const Widget*>() (key.widget) ^ (static_cast<size_t>(key.eventType) * 0x9e3779b9u);
+        }
+    };
+
     BEvents::Event::EventType eventQueueable_;
-    std::list<BEvents::Event*> eventQueue_;
+    BUtilities::RingBuffer<BEvents::Event*> eventQueue_;
+    size_t eventQueueFront_;
+    std::unordered_map<EventKey, BEvents::Event*, EventKeyHash> eventIndex_;
+    BEvents::EventPool eventPool_;
     
 public:
 
@@ -61,15 +98,31 @@ public:
      */
     bool isEventQueueable (const BEvents::Event::EventType eventType) const;
 
+    /**
+     *  @brief  Creates an event from the event pool.
+     *  @tparam T  Event type.
+     *  @param args  Parameters passed to the constructor of @a T .
+     *  @return  Pointer to the new event.
+     *
+     *  Events created by this method are intended to be passed to 
+     *  @c addEventToQueue() . Their memory is recycled once the event 
+     *  lifetime ends. If not passed to the event queue, the event must be 
+     *  released by calling @c BEvents::EventPool::dispose() and NOT by 
+     *  calling @c delete .
+     */
+    template <class T, typename... Args>
+    T* createEvent (Args&&... args);
+
     /**
 	 *  @brief  Queues an event.
 	 *  @param event  Pointer to the event.
 	 *
 	 *  Passes an @a event and adds it to the event queue. From now on, the 
      *  this object controls the @a event object lifetime. If the @a event
-     *  lifetime ends, the @a event is destructed by calling @c delete. Thus,
-     *  the @a event passed
-	 *  1. must be dynamicly allocated before by calling @c new, and
+     *  lifetime ends, the @a event is destructed by calling @c delete or 
+     *  recycled if created by @c createEvent() . Thus, the @a event passed
+	 *  1. must be dynamicly allocated before by calling @c new or 
+     *     @c createEvent() , and
 	 *  2. must NOT be deleted outside once it is passed to this object.
 	 *
      *  Does not add but deletes the passed event if the passed even is not
@@ -93,21 +146,50 @@ public:
      *  @brief  Pops the event from from somewhere in the event queue.
      *  @param event  Pointer to the event to be popped.
      *  @return  Pointer to the event or nullptr if not present.
+     *
+     *  Constant time.
      */
     virtual BEvents::Event* popEvent (BEvents::Event* event);
 
     /**
-     *  @brief  Removes an event from the event queue (if present) and calls
-     *  @c delete to de-allocate its memory.  
+     *  @brief  Removes an event from the event queue (if present) and 
+     *  de-allocates or recycles its memory.  
      *  @param event  Pointer to the event.
      */
     virtual void deleteEvent (BEvents::Event* event);
 
+protected:
+
+    /**
+     *  @brief  Gets the latest queued event of a widget and an event type.
+     *  @param widget  Widget which caused the event.
+     *  @param eventType  Event type.
+     *  @return  Pointer to the event or nullptr if not present.
+     *
+     *  Constant time lookup.
+     */
+    BEvents::Event* getQueuedEvent (const Widget* widget, const BEvents::Event::EventType eventType) const;
+
+    /**
+     *  @brief  Removes all events from the event queue for which a 
+     *  predicate returns true and de-allocates or recycles their memory.
+     *  @param func  Predicate function.
+     */
+    template <class Pred>
+    void removeEvents (Pred func);
+
+private:
+    void unindex (BEvents::Event* event);
+    void trimQueue ();
+
 };
 
 inline EventQueueable::EventQueueable() :
     eventQueueable_(BEvents::Event::EventType::all),
-    eventQueue_()
+    eventQueue_(),
+    eventQueueFront_(0),
+    eventIndex_(),
+    eventPool_()
 {}
 
 inline EventQueueable::~EventQueueable()
@@ -116,7 +198,9 @@ inline EventQueueable::~EventQueueable()
     {
         BEvents::Event* event = eventQueue_.front();
         eventQueue_.pop_front();
-        delete event;
+        if (!event) continue;
+        event->queue_ = nullptr;
+        BEvents::EventPool::dispose (event);
     }
 }
 
@@ -130,43 +214,103 @@ inline bool EventQueueable::isEventQueueable (const BEvents::Event::EventType ev
     return (eventQueueable_ & eventType) == eventType;
 }
 
+template <class T, typename... Args>
+inline T* EventQueueable::createEvent (Args&&... args)
+{
+    return eventPool_.create<T> (std::forward<Args>(args)...);
+}
+
 inline void EventQueueable::addEventToQueue (BEvents::Event* event)
 {
     if (!event) return;
 
-    // Add to the event queue
+    // Add to the event queue (but only once)
     if (isEventQueueable (event->getEventType()))
     {
-        if (std::find (eventQueue_.begin(), eventQueue_.end(), event) ==  eventQueue_.end()) eventQueue_.push_back (event);
+        if (event->queue_ != this)
+        {
+            event->queuePosition_ = eventQueueFront_ + eventQueue_.size();
+            eventQueue_.push_back (event);
+            event->queue_ = this;
+            eventIndex_[EventKey {event->getWidget(), event->getEventType()}] = event;
+        }
     }
 
     // Not queueable: discard event
-    else delete event;
+    else BEvents::EventPool::dispose (event);
 }
 
 inline BEvents::Event* EventQueueable::popEvent ()
 {
+    if (eventQueue_.empty()) return nullptr;
     BEvents::Event* event = eventQueue_.front();
     eventQueue_.pop_front();
+    ++eventQueueFront_;
+    trimQueue();
+    unindex (event);
     return event;
 }
 
 inline BEvents::Event* EventQueueable::popEvent (BEvents::Event* event)
 {
-    std::list<BEvents::Event*>::const_iterator it = std::find (eventQueue_.begin(), eventQueue_.end(), event);
-    if (it == eventQueue_.cend()) return nullptr;
-    else
-    {
-        BEvents::Event* e = *it;
-        eventQueue_.erase (it);
-        return e;
-    }
+    // Not in this queue
+    if ((!event) || (event->queue_ != this)) return nullptr;
+
+    // Leave an empty slot
+    eventQueue_[event->queuePosition_ - eventQueueFront_] = nullptr;
+    trimQueue();
+    unindex (event);
+    return event;
 }
 
 inline void EventQueueable::deleteEvent (BEvents::Event* event)
 {
     popEvent (event);
-    delete event;
+    BEvents::EventPool::dispose (event);
+}
+
+inline BEvents::Event* EventQueueable::getQueuedEvent (const Widget* widget, const BEvents::Event::EventType eventType) const
+{
+    std::unordered_map<EventKey, BEvents::Event*, EventKeyHash>::const_iterator it = eventIndex_.find (EventKey {widget, eventType});
+    return (it != eventIndex_.cend() ? it->second : nullptr);
+}
+
+template <class Pred>
+inline void EventQueueable::removeEvents (Pred func)
+{
+    eventQueue_.remove_if
+    (
+        [this, &func] (BEvents::Event* event)
+        {
+            if (!event) return true;    // Empty slot
+            if (!func (event)) return false;
+            unindex (event);
+            BEvents::EventPool::dispose (event);
+            return true;
+        }
+    );
+
+    // Renumber the remaining events
+    eventQueueFront_ = 0;
+    for (size_t i = 0; i < eventQueue_.size(); ++i) eventQueue_[i]->queuePosition_ = i;
+}
+
+inline void EventQueueable::unindex (BEvents::Event* event)
+{
+    event->queue_ = nullptr;
+    std::unordered_map<EventKey, BEvents::Event*, EventKeyHash>::iterator it = eventIndex_.find (EventKey {event->getWidget(), event->getEventType()});
+
+    if ((it != eventIndex_.end()) && (it->second == event)) eventIndex_.erase (it);
+}
+
+inline void EventQueueable::trimQueue ()
+{
+    // Keep a valid event in front
+    while ((!eventQueue_.empty()) && (eventQueue_.front() == nullptr))
+    {
+        eventQueue_.pop_front();
+        ++eventQueueFront_;
+    }
 }
 
 }
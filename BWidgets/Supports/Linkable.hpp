@@ -19,6 +19,8 @@
 #define BWIDGETS_LINKABLE_HPP_
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <list>
 #include <functional>
 #include "Support.hpp"
@@ -38,6 +40,7 @@ protected:
     Linkable* parent_;
 	Linkable* main_;
     std::list<Linkable*> children_;
+	uint64_t treeGeneration_;
 
 public:
 	Linkable ();
@@ -173,13 +176,34 @@ public:
 						 std::list<Linkable*>::const_iterator last,
 						 std::function<bool (Linkable* obj)> func = [] (Linkable* obj) {return true;}) const;
 
+	/**
+	 *  @brief  Gets the generation of the tree this object belongs to.
+	 *  @return  Generation of the tree.
+	 *
+	 *  The generation is stored in the main object and changes each time
+	 *  the tree is invalidated by invalidateTree(). Generations are unique
+	 *  process-wide, so that objects moved between trees never match a
+	 *  stale generation.
+	 */
+	uint64_t getTreeGeneration () const;
+
+protected:
+	/**
+	 *  @brief  Assigns a new generation to the tree this object belongs to.
+	 */
+	void invalidateTree ();
+
+private:
+	static uint64_t newTreeGeneration ();
+
 };
 
 inline Linkable::Linkable () :
 	Support(),
     parent_ (nullptr),
 	main_ (this),
-    children_ ()
+    children_ (),
+	treeGeneration_ (newTreeGeneration ())
 {
 
 }
@@ -279,6 +303,22 @@ inline Linkable* Linkable::getMain () const
 	return main_;
 }
 
+inline uint64_t Linkable::getTreeGeneration () const
+{
+	return (main_ ? main_->treeGeneration_ : treeGeneration_);
+}
+
+inline void Linkable::invalidateTree ()
+{
+	(main_ ? main_->treeGeneration_ : treeGeneration_) = newTreeGeneration ();
+}
+
+inline uint64_t Linkable::newTreeGeneration ()
+{
+	static std::atomic<uint64_t> generation (1);
+	return generation.fetch_add (1, std::memory_order_relaxed);
+}
+
 inline bool Linkable::hasChildren () const
 {
 	return !children_.empty();
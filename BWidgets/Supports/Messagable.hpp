@@ -84,8 +84,9 @@ inline void Messagable::postMessage (const std::string& name, const BUtilities::
     Linkable* m = thisWidget->getMain();
     if (!m) return;
     EventQueueable* q = dynamic_cast<EventQueueable*>(m);
+    if (!q) return;
 
-    BEvents::MessageEvent* event = new BEvents::MessageEvent (thisWidget, name, content);
+    BEvents::MessageEvent* event = q->createEvent<BEvents::MessageEvent> (thisWidget, name, content);
 	q->addEventToQueue (event);
 }
 
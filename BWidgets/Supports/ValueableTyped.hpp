@@ -115,9 +115,12 @@ void ValueableTyped<T>::setValue (const T& value)
     // Set new value_
     if (value_ != nval)
     {
+        // Redraw the value dependent areas before and after the change
+        Widget* widget = dynamic_cast<Widget*>(this);
+        const BUtilities::Area<> a0 = (widget ? widget->getDependentArea (Widget::DrawDependency::value) : BUtilities::Area<> ());
         value_ = nval;
         if (isValueable()) emitValueChanged();
-        if (dynamic_cast<Widget*>(this)) dynamic_cast<Widget*>(this)->update();
+        if (widget) widget->updateArea (Widget::DrawDependency::value, a0);
     }
 }
 
@@ -135,7 +138,7 @@ void ValueableTyped<T>::emitValueChanged ()
     
     if (thisWidget->getMainWindow())
 	{
-		BEvents::ValueChangeTypedEvent<T>* event = new BEvents::ValueChangeTypedEvent<T> (thisWidget, value_);
+		BEvents::ValueChangeTypedEvent<T>* event = thisWidget->getMainWindow()->createEvent<BEvents::ValueChangeTypedEvent<T>> (thisWidget, value_);
 		thisWidget->getMainWindow()->addEventToQueue (event);
 	}
 }
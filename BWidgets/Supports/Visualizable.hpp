@@ -19,9 +19,13 @@
 #define BWIDGETS_VISUALIZABLE_HPP_
 
 #include <cairo/cairo.h>
+#include <cmath>
+#include <cstdint>
 #include <limits>
 #include "../../BUtilities/cairoplus.h"
 #include "../../BUtilities/Area.hpp"
+#include "../../BUtilities/Region.hpp"
+#include "../../BUtilities/SurfacePool.hpp"
 #include "Callback.hpp"
 #include "Support.hpp"
 
@@ -29,6 +33,14 @@
 #define BWIDGETS_UNDEFINED_LAYER (std::numeric_limits<int>::max())
 #endif
 
+#ifndef BWIDGETS_DEFAULT_SURFACE_BUDGET
+#define BWIDGETS_DEFAULT_SURFACE_BUDGET 0
+#endif
+
+#ifndef BWIDGETS_DEFAULT_SURFACE_POOL_SIZE
+#define BWIDGETS_DEFAULT_SURFACE_POOL_SIZE (16 * 1024 * 1024)
+#endif
+
 namespace BWidgets
 {
 
@@ -49,6 +61,28 @@ namespace BWidgets
  *
  *  If the main window (then) receives a host system expose event, the
  *  main window updates the visual content covered by this event.
+ *
+ *  The RGBA surface is created at the device scale (see @c setScale() ).
+ *  Draw methods work in logical (non-scaled) units as the device scale is
+ *  part of the surface transformation.
+ *
+ *  The RGBA surface is allocated lazily upon the first visible draw (see
+ *  @c validateSurface() ). Each main Window keeps the allocated surfaces of
+ *  its objects in a least recently used list (see @c getSurfaceList() ). If
+ *  the total size of these surfaces exceeds the surface budget of the 
+ *  Window (see @c Window::setSurfaceBudget() ), the least recently used 
+ *  surfaces are released. Hidden objects are moved to the end of the list.
+ *  Released surfaces are re-allocated and redrawn on demand.
+ *
+ *  Surfaces are taken from and returned to a process-wide size-bucketed
+ *  pool (see @c BUtilities::SurfacePool ). Thus, the surfaces may be larger 
+ *  than the object extends. A surface is only re-allocated if it becomes 
+ *  too small (or much too large) for the object extends.
+ *
+ *  Objects which completely cover their area with opaque content may be
+ *  marked as opaque (see @c setOpaque() ). Opaque objects use RGB surfaces
+ *  without an alpha channel and objects fully covered by opaque objects are
+ *  not composited by the main Window.
  */
 class Visualizable : virtual public Callback, public Support
 {
@@ -57,13 +91,34 @@ protected:
     {
         cairo_surface_t* surface;
         double scale;
+        size_t bytes;
+        BUtilities::Point<> drawnExtends;
+    };
+
+    struct SurfaceList
+    {
+        Visualizable* front;
+        Visualizable* back;
+        size_t bytes;
+        size_t budget;
+        uint64_t frame;
+        bool pinned;
     };
 
     bool scheduleDraw_;
+    BUtilities::Region<> drawRegion_;
+    bool concurrentDraw_;
+    bool opaque_;
     BUtilities::Point<> extends_;
     Surface surface_;
     int layer_;
 
+private:
+    SurfaceList* lruList_;
+    Visualizable* lruPrev_;
+    Visualizable* lruNext_;
+    uint64_t lruFrame_;
+
 public:
 
     /**
@@ -138,8 +193,8 @@ public:
      *  @brief  Sets the object surface width.
      *  @param width  Surface width.
      *
-     *  Creates a new RGBA surface with the new width, copies the surface
-     *  data from the previous surface, and calls @c update() .
+     *  Changes the width and calls @c update() . The surface is
+     *  re-allocated upon the next display if it becomes too small.
      */
     virtual void setWidth (const double width);
 
@@ -153,8 +208,8 @@ public:
      *  @brief  Sets the object surface height.
      *  @param width  Surface height.
      *
-     *  Creates a new RGBA surface with the new height, copies the surface
-     *  data from the previous surface, and calls @c update() .
+     *  Changes the height and calls @c update() . The surface is
+     *  re-allocated upon the next display if it becomes too small.
      */
     virtual void setHeight (const double height);
 
@@ -167,8 +222,9 @@ public:
     /**
      *  @brief  Optimizes the object surface extends.
      *
-     *  Creates a new RGBA surface with the new optimized extends, copies the
-     *  surface data from the previous surface, and calls @c update() .
+     *  Changes the extends to the optimized extends and calls 
+     *  @c update() . The surface is re-allocated upon the next display if
+     *  it becomes too small.
 	 */
 	virtual void resize ();
 
@@ -177,8 +233,8 @@ public:
 	 *  @param width  New object width.
 	 *  @param height  New object height.
      *
-     *  Creates a new RGBA surface with the new extends, copies the 
-     *  surface data from the previous surface, and calls @c update() .
+     *  Changes the extends and calls @c update() . The surface is
+     *  re-allocated upon the next display if it becomes too small.
 	 */
 	virtual void resize (const double width, const double height);
 
@@ -186,8 +242,8 @@ public:
 	 *  @brief  Resizes the object surface extends.
 	 *  @param extends  New object extends.
      *
-     *  Creates a new RGBA surface with the new extends, copies the 
-     *  surface data from the previous surface, and calls @c update() .
+     *  Changes the extends and calls @c update() . The surface is
+     *  re-allocated upon the next display if it becomes too small.
 	 */
 	virtual void resize (const BUtilities::Point<> extends);
 
@@ -219,6 +275,70 @@ public:
      */
     virtual int getLayer () const;
 
+    /**
+     *  @brief  Sets the device scale of the object surface.
+     *  @param scale  Device scale (number of device pixels per logical
+     *  unit).
+     *
+     *  Releases the surface and schedules a redraw. The new surface is 
+     *  created with the extends multiplied by @a scale upon the next
+     *  display. The main Window sets the device scale of all
+     *  linked objects to its zoom factor. Thus, the visual content is
+     *  rendered at the device resolution and doesn't need to be scaled upon
+     *  exposure.
+     */
+    virtual void setScale (const double scale);
+
+    /**
+     *  @brief  Gets the device scale of the object surface.
+     *  @return  Device scale.
+     */
+    double getScale () const;
+
+    /**
+     *  @brief  Sets the opaque hint.
+     *  @param status  True if opaque, otherwise false (default).
+     *
+     *  Opaque objects promise to cover their whole area with fully opaque
+     *  content. They are drawn to an RGB surface without an alpha channel
+     *  (CAIRO_FORMAT_RGB24) and allow the main Window to skip the 
+     *  composition of all objects covered by them. Non-covered parts of an
+     *  opaque surface are displayed black.
+     */
+    virtual void setOpaque (const bool status);
+
+    /**
+     *  @brief  Information about the opaque hint.
+     *  @return  True if opaque, otherwise false.
+     */
+    bool isOpaque () const;
+
+    /**
+     *  @brief  Information whether the object surface needs to be redrawn.
+     *  @return  True if a full or a partial redraw is scheduled, otherwise
+     *  false.
+     */
+    bool isDrawScheduled () const;
+
+    /**
+     *  @brief  Allows or forbids drawing in a worker thread.
+     *  @param status  True if allowed (default), otherwise false.
+     *
+     *  If parallel drawing is enabled in the main Window (see 
+     *  @c Window::setDrawThreads() ), the main Window may call the
+     *  draw methods of objects that allow concurrent drawing in worker 
+     *  threads. Objects whose draw methods access data shared with other
+     *  objects (other than reading their own style and value) or emit
+     *  events must forbid concurrent drawing.
+     */
+    void setConcurrentDraw (const bool status);
+
+    /**
+     *  @brief  Information whether drawing in a worker thread is allowed.
+     *  @return  True if allowed, otherwise false.
+     */
+    bool isConcurrentDraw () const;
+
     /**
      *  @brief  Method to be called following an object state change.
      *
@@ -240,10 +360,53 @@ public:
     
     /**
      *  @brief  Access to the Cairo surface.
-     *  @return  Pointer to the Cairo surface.
+     *  @return  Pointer to the Cairo surface or nullptr if the surface is
+     *  not (yet) allocated.
      */
     cairo_surface_t* cairoSurface() const;
 
+    /**
+     *  @brief  Releases the Cairo surface.
+     *
+     *  The surface will be re-allocated and redrawn on demand.
+     */
+    void releaseSurface ();
+
+    /**
+     *  @brief  Gets the memory size of the Cairo surface.
+     *  @return  Size in bytes or 0 if the surface is not allocated.
+     */
+    size_t getSurfaceBytes () const;
+
+    /**
+     *  @brief  Gets the extends of the last drawn surface content.
+     *  @return  Extends at the time of the last draw.
+     *
+     *  Differs from @c getExtends() if the object has been resized since
+     *  the last draw.
+     */
+    BUtilities::Point<> getDrawnExtends () const;
+
+    /**
+     *  @brief  Access to the process-wide pool of released surfaces.
+     *  @return  Reference to the surface pool.
+     *
+     *  The pool keeps up to BWIDGETS_DEFAULT_SURFACE_POOL_SIZE bytes of 
+     *  released surfaces by default. The pool is thread-safe and shared by
+     *  all Windows.
+     */
+    static BUtilities::SurfacePool& getSurfacePool ();
+
+    /**
+     *  @brief  Access to a process-wide scratch surface for measurements.
+     *  @return  Pointer to a 1 x 1 Cairo image surface.
+     *
+     *  Create Cairo contexts on the scratch surface to measure (e. g., text
+     *  extends) independent of the lazily allocated object surface. Never
+     *  draw to the scratch surface.
+     */
+    static cairo_surface_t* getScratchSurface ();
+
     /**
      *  @brief  Method called upon an configure request event.
      *  @param event  Passed Event.
@@ -292,6 +455,79 @@ protected:
      */
     virtual void draw (const BUtilities::Area<>& area);
 
+    /**
+     *  @brief  Creates an image surface at a device scale.
+     *  @param extends  Extends in logical units.
+     *  @param scale  Device scale.
+     *  @param format  Optional, Cairo image format. Default is 
+     *  CAIRO_FORMAT_ARGB32.
+     *  @return  Pointer to the new Cairo surface.
+     */
+    static cairo_surface_t* createSurface (const BUtilities::Point<> extends, const double scale, const cairo_format_t format = CAIRO_FORMAT_ARGB32);
+
+    /**
+     *  @brief  Gets the least recently used list for the surface.
+     *  @return  Pointer to the list or nullptr if the surface is not subject
+     *  to a surface budget.
+     *
+     *  Default method to be overridden. Widgets return the list of their
+     *  main Window.
+     */
+    virtual SurfaceList* getSurfaceList () const;
+
+    /**
+     *  @brief  Moves the surface to another least recently used list.
+     *  @param list  Pointer to the list or nullptr.
+     */
+    void setSurfaceList (SurfaceList* list);
+
+    /**
+     *  @brief  Makes the Cairo surface available for drawing.
+     *  @return  True if the surface is available, otherwise false.
+     *
+     *  Allocates the surface (and schedules a redraw) if not yet done and
+     *  marks the surface as most recently used. Releases least recently 
+     *  used surfaces of other objects in the same list if the surface 
+     *  budget is exceeded. Surfaces validated while the list is pinned
+     *  (e. g., during a frame of the main Window) are not released. Must be
+     *  called from the main thread.
+     */
+    bool validateSurface ();
+
+    /**
+     *  @brief  Performs the scheduled redraw.
+     *
+     *  Calls @c draw() if a full redraw is scheduled. Otherwise calls 
+     *  @c draw(area) for each area of the scheduled partial redraw (aligned
+     *  to device pixels).
+     */
+    void redraw ();
+
+    /**
+     *  @brief  Marks the Cairo surface as least recently used.
+     *
+     *  Makes the surface the first candidate for release if the surface
+     *  budget is exceeded (e. g., for hidden objects).
+     */
+    void demoteSurface ();
+
+    /**
+     *  @brief  Releases least recently used surfaces of a list until the
+     *  list meets its budget.
+     *  @param list  Least recently used list.
+     *  @param keep  Optional, object not to be released.
+     *
+     *  Surfaces validated while the list is pinned are kept.
+     */
+    static void enforceSurfaceBudget (SurfaceList& list, const Visualizable* keep = nullptr);
+
+private:
+    void setSurface (cairo_surface_t* surface);
+
+    void lruLink (const bool front);
+
+    void lruUnlink ();
+
 };
 
 inline Visualizable::Visualizable () : 
@@ -310,9 +546,16 @@ inline Visualizable::Visualizable (const BUtilities::Point<> extends) :
     Callback(),
     Support(),
     scheduleDraw_ (true),
+    drawRegion_ (),
+    concurrentDraw_ (true),
+    opaque_ (false),
     extends_ (extends),
-    surface_ {cairo_image_surface_create (CAIRO_FORMAT_ARGB32, extends.x, extends.y), 1.0},
-    layer_ (0)
+    surface_ {nullptr, 1.0, 0, BUtilities::Point<> ()},
+    layer_ (0),
+    lruList_ (nullptr),
+    lruPrev_ (nullptr),
+    lruNext_ (nullptr),
+    lruFrame_ (0)
 {
 
 }
@@ -321,16 +564,23 @@ inline Visualizable::Visualizable (const Visualizable& that) :
     Callback (that),
     Support (that),
     scheduleDraw_ (that.scheduleDraw_),
+    drawRegion_ (that.drawRegion_),
+    concurrentDraw_ (that.concurrentDraw_),
+    opaque_ (that.opaque_),
     extends_ (that.extends_),
-    surface_ {cairoplus_image_surface_clone_from_image_surface (that.surface_.surface), that.surface_.scale},
-    layer_ (that.layer_)
+    surface_ {nullptr, that.surface_.scale, 0, that.surface_.drawnExtends},
+    layer_ (that.layer_),
+    lruList_ (nullptr),
+    lruPrev_ (nullptr),
+    lruNext_ (nullptr),
+    lruFrame_ (0)
 {
-
+    if (that.surface_.surface) setSurface (cairoplus_image_surface_clone_from_image_surface (that.surface_.surface));
 }
 
 inline Visualizable::~Visualizable ()
 {
-    cairo_surface_destroy (surface_.surface);
+    setSurface (nullptr);
 }
 
 inline Visualizable& Visualizable::operator= (const Visualizable& that)
@@ -338,10 +588,13 @@ inline Visualizable& Visualizable::operator= (const Visualizable& that)
     Callback::operator= (that);
     Support::operator= (that);
     scheduleDraw_ = that.scheduleDraw_;
+    drawRegion_ = that.drawRegion_;
+    concurrentDraw_ = that.concurrentDraw_;
+    opaque_ = that.opaque_;
     extends_ = that.extends_;
-    if (surface_.surface) cairo_surface_destroy (surface_.surface);
-    surface_.surface = cairoplus_image_surface_clone_from_image_surface (that.surface_.surface);
+    setSurface (that.surface_.surface ? cairoplus_image_surface_clone_from_image_surface (that.surface_.surface) : nullptr);
     surface_.scale = that.surface_.scale;
+    surface_.drawnExtends = that.surface_.drawnExtends;
     layer_ = that.layer_;
 
     update();
@@ -364,6 +617,7 @@ inline void Visualizable::show ()
 inline void Visualizable::hide ()
 {
     setSupport (false);
+    demoteSurface ();
 }
 
 inline bool Visualizable::isVisualizable () const 
@@ -424,31 +678,67 @@ inline void Visualizable::resize (const BUtilities::Point<> extends)
 {
     if ((extends.x != extends_.x) || (extends.y != extends_.y))
     {
+        // Keep the surface (and its content for preview) until the next
+        // display, see validateSurface()
         extends_ = BUtilities::Point<> (std::max (extends.x, 0.0), std::max (extends.y, 0.0));
+        update();
+    }
+}
 
-        // Create new surface
-        cairo_surface_t* new_surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, extends_.x, extends_.y);
+inline void Visualizable::setScale (const double scale)
+{
+    if ((scale > 0.0) && (scale != surface_.scale))
+    {
+        releaseSurface ();
+        surface_.scale = scale;
+    }
+}
 
-        // Copy surface
-		if (new_surface && (cairo_surface_status (new_surface) == CAIRO_STATUS_SUCCESS))
-		{
-            cairo_t* cr = cairo_create (new_surface);
-			if (cr && (cairo_status (cr) == CAIRO_STATUS_SUCCESS))
-			{
-				cairo_set_source_surface (cr, cairoSurface(), 0, 0);
-				cairo_paint (cr);
-				cairo_destroy (cr);
-			}
-		}
+inline void Visualizable::setOpaque (const bool status)
+{
+    if (status != opaque_)
+    {
+        opaque_ = status;
+        releaseSurface ();
+        update ();
+    }
+}
 
-        // Delete old surface
-        cairo_surface_destroy (cairoSurface());
+inline bool Visualizable::isOpaque () const
+{
+    return opaque_;
+}
 
-        // Copy new surface pointer
-        surface_.surface = new_surface;
+inline bool Visualizable::isDrawScheduled () const
+{
+    return (scheduleDraw_ || (!drawRegion_.empty()));
+}
 
-        update();
-    }
+inline void Visualizable::setConcurrentDraw (const bool status)
+{
+    concurrentDraw_ = status;
+}
+
+inline bool Visualizable::isConcurrentDraw () const
+{
+    return concurrentDraw_;
+}
+
+inline double Visualizable::getScale () const
+{
+    return surface_.scale;
+}
+
+inline cairo_surface_t* Visualizable::createSurface (const BUtilities::Point<> extends, const double scale, const cairo_format_t format)
+{
+    cairo_surface_t* s = cairo_image_surface_create 
+    (
+        format, 
+        static_cast<int> (std::ceil (extends.x * scale)), 
+        static_cast<int> (std::ceil (extends.y * scale))
+    );
+    if (s && (cairo_surface_status (s) == CAIRO_STATUS_SUCCESS)) cairo_surface_set_device_scale (s, scale, scale);
+    return s;
 }
 
 inline BUtilities::Point<> Visualizable::getExtends () const 
@@ -467,6 +757,208 @@ inline cairo_surface_t* Visualizable::cairoSurface() const
     return surface_.surface;
 }
 
+inline void Visualizable::releaseSurface ()
+{
+    setSurface (nullptr);
+    scheduleDraw_ = true;
+}
+
+inline size_t Visualizable::getSurfaceBytes () const
+{
+    return surface_.bytes;
+}
+
+inline BUtilities::Point<> Visualizable::getDrawnExtends () const
+{
+    return surface_.drawnExtends;
+}
+
+inline BUtilities::SurfacePool& Visualizable::getSurfacePool ()
+{
+    // Never destroyed as static objects may release surfaces upon exit
+    static BUtilities::SurfacePool* pool = new BUtilities::SurfacePool (BWIDGETS_DEFAULT_SURFACE_POOL_SIZE);
+    return *pool;
+}
+
+inline cairo_surface_t* Visualizable::getScratchSurface ()
+{
+    // Never destroyed as static objects may measure text upon exit
+    static cairo_surface_t* surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 1, 1);
+    return surface;
+}
+
+inline Visualizable::SurfaceList* Visualizable::getSurfaceList () const
+{
+    return nullptr;
+}
+
+inline void Visualizable::setSurfaceList (SurfaceList* list)
+{
+    if (list == lruList_) return;
+
+    if (surface_.surface && lruList_)
+    {
+        lruUnlink ();
+        lruList_->bytes -= surface_.bytes;
+    }
+
+    lruList_ = list;
+
+    if (surface_.surface && lruList_)
+    {
+        lruList_->bytes += surface_.bytes;
+        lruLink (true);
+    }
+}
+
+inline bool Visualizable::validateSurface ()
+{
+    setSurfaceList (getSurfaceList());
+
+    // Required device size
+    const int w = static_cast<int> (std::ceil (extends_.x * surface_.scale));
+    const int h = static_cast<int> (std::ceil (extends_.y * surface_.scale));
+
+    // (Re-)allocate if not allocated, too small, or more than twice as large
+    // as needed
+    if 
+    (
+        (!surface_.surface) ||
+        (cairo_image_surface_get_width (surface_.surface) < w) ||
+        (cairo_image_surface_get_height (surface_.surface) < h) ||
+        (   static_cast<double> (cairo_image_surface_get_width (surface_.surface)) * cairo_image_surface_get_height (surface_.surface) > 
+            2.0 * BUtilities::SurfacePool::getBucketSize (w) * BUtilities::SurfacePool::getBucketSize (h))
+    )
+    {
+        cairo_surface_t* s = getSurfacePool().acquire ((opaque_ ? CAIRO_FORMAT_RGB24 : CAIRO_FORMAT_ARGB32), w, h);
+        if (s && (cairo_surface_status (s) == CAIRO_STATUS_SUCCESS)) cairo_surface_set_device_scale (s, surface_.scale, surface_.scale);
+        setSurface (s);
+        scheduleDraw_ = true;
+    }
+
+    else if (lruList_ && (lruList_->front != this))
+    {
+        lruUnlink ();
+        lruLink (true);
+    }
+
+    if (lruList_)
+    {
+        lruFrame_ = lruList_->frame;
+        enforceSurfaceBudget (*lruList_, this);
+    }
+    return (surface_.surface && (cairo_surface_status (surface_.surface) == CAIRO_STATUS_SUCCESS));
+}
+
+inline void Visualizable::redraw ()
+{
+    if (scheduleDraw_) draw ();
+
+    else
+    {
+        // Align to device pixels, so that cleared and redrawn pixels match
+        const double s = surface_.scale;
+        for (const BUtilities::Area<>& a : drawRegion_)
+        {
+            const double x1 = std::floor (a.getX() * s) / s;
+            const double y1 = std::floor (a.getY() * s) / s;
+            const double x2 = std::ceil ((a.getX() + a.getWidth()) * s) / s;
+            const double y2 = std::ceil ((a.getY() + a.getHeight()) * s) / s;
+            draw (BUtilities::Area<> (x1, y1, x2 - x1, y2 - y1));
+        }
+    }
+
+    drawRegion_.clear();
+}
+
+inline void Visualizable::demoteSurface ()
+{
+    if (surface_.surface && lruList_ && (lruList_->back != this))
+    {
+        lruUnlink ();
+        lruLink (false);
+    }
+}
+
+inline void Visualizable::setSurface (cairo_surface_t* surface)
+{
+    if (surface_.surface)
+    {
+        if (lruList_)
+        {
+            lruUnlink ();
+            lruList_->bytes -= surface_.bytes;
+        }
+        getSurfacePool().release (surface_.surface);
+    }
+
+    surface_.surface = surface;
+    surface_.bytes = 0;
+
+    if (surface)
+    {
+        if (cairo_surface_status (surface) == CAIRO_STATUS_SUCCESS)
+        {
+            surface_.bytes =    static_cast<size_t> (cairo_image_surface_get_stride (surface)) * 
+                                static_cast<size_t> (cairo_image_surface_get_height (surface));
+        }
+        if (lruList_)
+        {
+            lruList_->bytes += surface_.bytes;
+            lruLink (true);
+        }
+    }
+}
+
+inline void Visualizable::lruLink (const bool front)
+{
+    if (front)
+    {
+        lruPrev_ = nullptr;
+        lruNext_ = lruList_->front;
+        if (lruList_->front) lruList_->front->lruPrev_ = this;
+        else lruList_->back = this;
+        lruList_->front = this;
+    }
+
+    else
+    {
+        lruNext_ = nullptr;
+        lruPrev_ = lruList_->back;
+        if (lruList_->back) lruList_->back->lruNext_ = this;
+        else lruList_->front = this;
+        lruList_->back = this;
+    }
+}
+
+inline void Visualizable::lruUnlink ()
+{
+    if (lruPrev_) lruPrev_->lruNext_ = lruNext_;
+    else if (lruList_->front == this) lruList_->front = lruNext_;
+    if (lruNext_) lruNext_->lruPrev_ = lruPrev_;
+    else if (lruList_->back == this) lruList_->back = lruPrev_;
+    lruPrev_ = nullptr;
+    lruNext_ = nullptr;
+}
+
+inline void Visualizable::enforceSurfaceBudget (SurfaceList& list, const Visualizable* keep)
+{
+    if (list.budget == 0) return;
+
+    // Stop at the first pinned surface. Validated surfaces are moved to the
+    // front. Thus, the surfaces in front of a pinned one are pinned too.
+    while 
+    (
+        (list.bytes > list.budget) && 
+        list.back && 
+        (list.back != keep) && 
+        (!(list.pinned && (list.back->lruFrame_ == list.frame)))
+    )
+    {
+        list.back->releaseSurface ();
+    }
+}
+
 inline void Visualizable::onConfigureRequest (BEvents::Event* event)
 {
     callback (BEvents::Event::EventType::configureRequestEvent) (event);
@@ -490,6 +982,7 @@ inline void Visualizable::draw (const double x0, const double y0, const double w
 inline void Visualizable::draw (const BUtilities::Area<>& area)
 {
     scheduleDraw_ = false;
+    surface_.drawnExtends = extends_;
 }
 }
 #endif /* BWIDGETS_VISUALIZABLE_HPP_ */
\ No newline at end of file
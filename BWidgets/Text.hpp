@@ -234,7 +234,7 @@ inline std::vector<std::string> Text::getTextBlock (double width)
 	std::vector<std::string> textblock;
 	const double w = (width <= 0.0 ? (getEffectiveWidth () <= 0.0 ? BWIDGETS_DEFAULT_TEXT_WIDTH - 2.0 * getXOffset() : getEffectiveWidth()) : width);
 	//const double h = getEffectiveHeight ();
-	cairo_t* cr = cairo_create (cairoSurface());
+	cairo_t* cr = cairo_create (getScratchSurface());
 	cairoplus_text_decorations decorations;
 	const BStyles::Font font = getFont();
 	strncpy (decorations.family, font.family.c_str (), 63);
@@ -267,7 +267,7 @@ inline std::vector<std::string> Text::getTextBlock (double width)
 inline double Text::getTextBlockHeight (std::vector<std::string> textBlock)
 {
 	double blockheight = 0.0;
-	cairo_t* cr = cairo_create (cairoSurface());
+	cairo_t* cr = cairo_create (getScratchSurface());
 	const BStyles::Font font = getFont();
 
 	for (std::string textline : textBlock)
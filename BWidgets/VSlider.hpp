@@ -121,6 +121,17 @@ public:
      */
     virtual void update () override;
 
+	/**
+	 *  @brief  Gets the area of the %VSlider which depends on a state 
+	 *  property.
+	 *  @param dependency  State property (value, status, or text).
+	 *  @return  Area relative to the %VSlider origin.
+	 *
+	 *  The value dependent area is the knob area (and the adjacent bar). 
+	 *  Thus, a value change only redraws the knob sweep.
+	 */
+	virtual BUtilities::Area<> getDependentArea (const DrawDependency dependency) const override;
+
 protected:
 	/**
      *  @brief  Unclipped draw a %VSlider to the surface.
@@ -204,6 +215,18 @@ inline void VSlider::update ()
 	Widget::update();
 }
 
+inline BUtilities::Area<> VSlider::getDependentArea (const DrawDependency dependency) const
+{
+	if (dependency == DrawDependency::layout) return scale_;
+	if (dependency != DrawDependency::value) return VScale::getDependentArea (dependency);
+
+	const double rval = getRatioFromValue (getValue());
+	const double y = scale_.getY() + (step_ >= 0.0 ? 1.0 - rval : rval) * scale_.getHeight();
+	const double r =	std::max (0.5 * (BWIDGETS_DEFAULT_SLIDER_KNOB_REL_SIZE / BWIDGETS_DEFAULT_SLIDER_BAR_REL_SIZE) * (scale_.getWidth() - 1.0), 0.5 * scale_.getWidth()) + 
+						2.0;
+	return BUtilities::Area<> (0.0, y - r, getWidth(), 2.0 * r);
+}
+
 inline void VSlider::draw ()
 {
 	draw (0, 0, getWidth(), getHeight());
@@ -54,11 +54,27 @@ Widget::Widget (const double x, const double y, const double width, const double
 	stacking_ (StackingType::normal),
 	status_(BStyles::Status::normal),
 	title_ (title),
-	style_ (),
 	focus_ (title == "" ? nullptr : new (std::nothrow) Label (title, BUtilities::Urid::urid (BUtilities::Urid::uri (urid) + "/focus"), "")),
 	focusTextFunction_([](const Widget* widget) {return (widget ? widget->getTitle() : "");}),
 	pushStyle_ (true),
-	devices_()
+	devices_(),
+	partialUpdate_ (false),
+	partialArea_ (),
+	partialDependent_ (false),
+	partialDependency_ (DrawDependency::value),
+	partialLayout_ (),
+	cacheGroup_ (false),
+	cacheGroupValid_ (false),
+	cacheGroupScale_ (0.0),
+	cacheGroupSurface_ (nullptr),
+	treeCache_ {0, nullptr, nullptr, BUtilities::Point<> (), BWIDGETS_UNDEFINED_LAYER, false},
+	style_ (emptyStyle ()),
+	styleSources_ (),
+	styleGeneration_ (0),
+	styleCascade_ (0),
+	styleStale_ (false),
+	styleChanged_ (false),
+	cascadedStyle_ (nullptr)
 {
 	if (focus_) 
 	{
@@ -73,8 +89,7 @@ Widget::Widget (const double x, const double y, const double width, const double
 Widget::~Widget ()
 {
 	// Delete all grapped devices
-	for (const BDevices::Device* d : devices_) delete d;
-	devices_.clear();
+	Widget::freeDevice ();
 
 	// Release from parent (and main) if still linked
 	if (parent_) parent_->release (this);
@@ -82,6 +97,7 @@ Widget::~Widget ()
 	// Release children
 	while (!children_.empty ()) release (children_.back ());
 
+	releaseCacheGroup ();
 	if (focus_) delete focus_;
 }
 
@@ -101,17 +117,25 @@ void Widget::copy (const Widget* that)
 	Activatable::operator= (*that);
 	Enterable::operator= (*that);
 	position_ = that->position_;
+	invalidateTreeCache ();
 	stacking_ = that->stacking_;
 	status_ = that->status_;
 	title_ = that->title_;
+	// Take the last resolved style of that
+	validateStyle ();
 	style_ = that->style_;
+	++styleGeneration_;
+	styleStale_ = false;
 	theme_ = that->theme_;
 	focusTextFunction_ = that->focusTextFunction_;
+	if (getMainWindow()) getMainWindow()->invalidateHitIndex();
 
 	if (focus_) delete focus_;
 	focus_ = (that->focus_ ? that->focus_->clone() : nullptr);
 
 	pushStyle_ = that->pushStyle_;
+	cacheGroup_ = that->cacheGroup_;
+	cacheGroupValid_ = false;
 
 	// Don't copy devices
 	
@@ -166,45 +190,41 @@ std::list<Linkable*>::iterator Widget::add (Linkable* child, std::function<void
 	Widget* childWidget = dynamic_cast<Widget*> (child);
 	if (!childWidget) return children_.end();
 
+	// Resolve pending styles of the child family before the themes change
+	childWidget->validateStyle ();
+	childWidget->validateFamilyStyles ();
+
 	std::list<Linkable*>::iterator it = Linkable::add 
 	(
 		child,
 		[addfunc] (Linkable* l)
 		{
 			Widget* w = dynamic_cast<Widget*>(l);
+			if (w) w->invalidateTreeCache ();
 			addfunc (l);
-			if (w) w->update ();
+			if (w) 
+			{
+				// Register already grabbed devices in the new main window
+				Window* main = w->getMainWindow();
+				if (main && (main != w))
+				{
+					for (const std::pair<uint64_t, BDevices::Device*>& d : w->devices_) main->addDeviceGrab (w, *d.second);
+				}
+
+				// Render at the device scale of the main window
+				if (main) w->setScale (main->getZoom());
+
+				w->update ();
+			}
 
 			// TODO Stacking
 		}
 	);
 
-	if (pushStyle_)
-	{
-		bool changed = false;
-		// 1) Forward styles in nested styles
-		BStyles::Style::iterator it = style_.find (childWidget->getUrid());
-		if (it != style_.end() && style_.isStyle (it)) 
-		{
-			childWidget->setStyle (it->second.get<BStyles::Style>());
-			changed = true;
-		}
-
-		// 2) Forward styles from themes
-		for (Widget* p = childWidget; p != nullptr; p = p->getParentWidget())
-		{
-			if (p->theme_.contains(childWidget->urid_)) 
-			{
-				childWidget->setStyle (p->theme_[childWidget->urid_]);
-				changed = true;
-				break;
-			}
-		}
-		
-		// 3) No change, only to start the setStyle() cascade.
-		if (!changed) childWidget->setStyle (childWidget->style_);
-	}
+	// Styles are resolved on demand
+	if (pushStyle_) childWidget->invalidateStyle ();
 
+	if (childWidget->getMainWindow()) childWidget->getMainWindow()->invalidateHitIndex();
 	return it;
 }
 
@@ -225,7 +245,12 @@ void Widget::release (Linkable* child, std::function<void (Linkable* obj)> relea
 
 	}
 
+	// Resolve pending styles of the child family before the themes change
+	childWidget->validateStyle ();
+	childWidget->validateFamilyStyles ();
+
 	bool wasVisible = childWidget->isVisible ();
+	if (getMainWindow()) getMainWindow()->invalidateHitIndex();
 	childWidget->hide();
 	Linkable::release
 	(
@@ -238,12 +263,15 @@ void Widget::release (Linkable* child, std::function<void (Linkable* obj)> relea
 			if (w && w->getMainWindow())
 			{
 				w->getMainWindow()->purgeEventQueue (w);
+				w->setSurfaceList (nullptr);
 				w->main_ = nullptr;
 				releasefunc (l);
 			}
 			return true;
 		}
 	);
+	invalidateTreeCache ();
+	childWidget->invalidateTreeCache ();
 
 	if (wasVisible) 
 	{
@@ -254,49 +282,38 @@ void Widget::release (Linkable* child, std::function<void (Linkable* obj)> relea
 
 void Widget::grabDevice (const BDevices::Device &device)
 {
-	devices_.insert(device.clone());
+	devices_.insert (device);
+	Window* main = getMainWindow();
+	if (main && (main != this)) main->addDeviceGrab (this, device);
 }
 
 void Widget::freeDevice ()
 {
-	for (BDevices::Device* d : devices_) delete d;
+	Window* main = getMainWindow();
+	if (main && (main != this))
+	{
+		for (const std::pair<uint64_t, BDevices::Device*>& d : devices_) main->removeDeviceGrab (this, *d.second);
+	}
 	devices_.clear();
 }
 
 void Widget::freeDevice (const BDevices::Device &device)
 {
-	for (std::set<BDevices::Device*>::iterator it = devices_.begin(); it != devices_.end(); /* empty */)
+	if (devices_.erase (device))
 	{
-		std::set<BDevices::Device*>::iterator nit = std::next(it);
-		BDevices::Device* d = *it;
-		if (*d == device)
-		{
-			delete d;
-			devices_.erase (it);
-		}
-
-		it = nit;
+		Window* main = getMainWindow();
+		if (main && (main != this)) main->removeDeviceGrab (this, device);
 	}
 }
 
 bool Widget::isDeviceGrabbed (const BDevices::Device& device) const
 {
-	for (BDevices::Device* d : devices_)
-	{
-		if (*d == device) return true;
-	}
-
-	return false;
+	return (devices_.find (device) != nullptr);
 }
 
 BDevices::Device* Widget::getDevice (const BDevices::Device& device) const
 {
-	for (BDevices::Device* d : devices_)
-	{
-		if (*d == device) return d;
-	}
-
-	return nullptr;
+	return devices_.find (device);
 }
 
 void Widget::raise ()
@@ -310,6 +327,8 @@ void Widget::raise ()
 		if (*it == this)
 		{
 			std::swap (*it, *(std::next (it)));
+			if (getMainWindow()) getMainWindow()->invalidateHitIndex();
+			invalidateCacheGroups ();
 			Widget* parentWidget = getParentWidget();
 			if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
 			break;
@@ -328,6 +347,8 @@ void Widget::drop ()
 		if (*it == this)
 		{
 			std::swap (*it, *(std::prev (it)));
+			if (getMainWindow()) getMainWindow()->invalidateHitIndex();
+			invalidateCacheGroups ();
 			Widget* parentWidget = getParentWidget();
 			if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
 			break;
@@ -345,6 +366,8 @@ void Widget::dropToBack ()
 	{
 		getParent()->getChildren().erase (it);
 		getParent()->getChildren().push_front (this);
+		if (getMainWindow()) getMainWindow()->invalidateHitIndex();
+		invalidateCacheGroups ();
 		Widget* parentWidget = getParentWidget();
 		if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
 	}
@@ -360,6 +383,8 @@ void Widget::raiseToFront ()
 	{
 		getParent()->getChildren().erase (it);
 		getParent()->getChildren().push_back (this);
+		if (getMainWindow()) getMainWindow()->invalidateHitIndex();
+		invalidateCacheGroups ();
 		Widget* parentWidget = getParentWidget();
 		if (parentWidget && parentWidget->isVisible ()) parentWidget->emitExposeEvent ();
 	}
@@ -367,24 +392,32 @@ void Widget::raiseToFront ()
 
 Window* Widget::getMainWindow () const 
 {
-	return dynamic_cast<Window*> (getMain());
+	validateTreeCache ();
+	return treeCache_.main;
 }
 
-Widget* Widget::getParentWidget () const {return dynamic_cast<Widget*> (getParent());}
+Widget* Widget::getParentWidget () const 
+{
+	validateTreeCache ();
+	return treeCache_.parent;
+}
 
 void Widget::show()
 {
 	if (isVisualizable()) return;
 
 	Visualizable::setSupport (true);
+	invalidateTreeCache ();
+	if (getMainWindow()) getMainWindow()->invalidateHitIndex();
 
 	if (isVisible ())
 	{
-		// (Re-)draw children as they may become visible too
+		// Schedule (re-)draw of children as they may become visible too.
+		// Surfaces are drawn (and allocated) upon display.
 		forEachChild ([] (Linkable* l)
 		{
 			Widget* w = dynamic_cast<Widget*>(l);
-			if (w && w->isVisible ()) w->draw (0, 0, w->getWidth (), w->getHeight ());
+			if (w && w->isVisible ()) w->scheduleDraw_ = true;
 			return w && w->isVisible ();
 		});
 
@@ -399,7 +432,17 @@ void Widget::hide()
 
 	// Get area occupied by this widget and its children
 	BUtilities::Area<> hideArea = getAbsoluteFamilyArea ([] (const Widget* w) {return w->isVisible();});
-	Visualizable::setSupport (false);
+	invalidateCacheGroups ();
+	releaseCacheGroup ();
+	Visualizable::hide ();
+	invalidateTreeCache ();
+	forEachChild ([] (Linkable* l)
+	{
+		Widget* w = dynamic_cast<Widget*>(l);
+		if (w) w->demoteSurface ();
+		return (w != nullptr);
+	});
+	if (getMainWindow()) getMainWindow()->invalidateHitIndex();
 
 	if (wasVisible && (this != dynamic_cast<Widget*> (getMainWindow())))
 	{
@@ -418,25 +461,16 @@ void Widget::hide()
 
 bool Widget::isVisible() const
 {
-	// Go backwards in widget tree until nullptr
-	for (const Widget* w = this; w; w = w->getParentWidget())			
-	{
-		// widget invisible? -> break as invisible
-		if (!w->isVisualizable()) return false;
-
-		// main reached ? -> visible
-		if (w == dynamic_cast<Widget*>(getMainWindow())) return true;
-
-		// no main window -> break as invisible;
-		if  (!w->getMainWindow()) return false;
-	}
-
-	// nullptr reached ? -> not connected to main -> invisible
-	return false;						
+	// Own visibility is not cached, only the visibility of the parents
+	if (!isVisualizable()) return false;
+	validateTreeCache ();
+	return treeCache_.visible;
 }
 
 void Widget::update()
 {
+	invalidateCacheGroups ();
+
 	if (focusTextFunction_)
 	{
 		Label* f = dynamic_cast<Label*>(focus_);
@@ -445,7 +479,63 @@ void Widget::update()
 			f->setText(focusTextFunction_(this));
 			f->resize();		}
 	}
-	Visualizable::update();
+
+	// Layout updated: add the dependent area after the change. Full update
+	// if the layout changed.
+	if (partialUpdate_ && partialDependent_)
+	{
+		const BUtilities::Area<> all = BUtilities::Area<> (0, 0, getWidth(), getHeight());
+		if (getDependentArea (DrawDependency::layout) != partialLayout_) partialUpdate_ = false;
+		else
+		{
+			const BUtilities::Area<> a1 = getDependentArea (partialDependency_);
+			if (partialArea_ == BUtilities::Area<> ()) partialArea_ = a1;
+			else partialArea_.extend (a1);
+			partialArea_.intersect (all);
+			partialUpdate_ = (partialArea_ != all);
+		}
+	}
+
+	// Partial update: schedule redraw and redisplay of the area only
+	if (partialUpdate_)
+	{
+		if (!scheduleDraw_) drawRegion_.add (partialArea_);
+		if (isVisible ())
+		{
+			BUtilities::Area<> a = partialArea_;
+			a.moveTo (a.getPosition() + getAbsolutePosition());
+			emitExposeEvent (a);
+		}
+	}
+
+	else Visualizable::update();
+}
+
+void Widget::updateArea (const BUtilities::Area<>& area)
+{
+	BUtilities::Area<> a = area;
+	const BUtilities::Area<> all = BUtilities::Area<> (0, 0, getWidth(), getHeight());
+	a.intersect (all);
+
+	// Full update if the whole widget is affected
+	partialUpdate_ = (a != all);
+	partialArea_ = a;
+	update ();
+	partialUpdate_ = false;
+}
+
+void Widget::updateArea (const DrawDependency dependency, const BUtilities::Area<>& area)
+{
+	partialDependent_ = true;
+	partialDependency_ = dependency;
+	partialLayout_ = getDependentArea (DrawDependency::layout);
+	updateArea (area);
+	partialDependent_ = false;
+}
+
+BUtilities::Area<> Widget::getDependentArea (const DrawDependency dependency) const
+{
+	return BUtilities::Area<> (0, 0, getWidth(), getHeight());
 }
 
 void Widget::resize ()
@@ -468,6 +558,7 @@ void Widget::resize (const double width, const double height)
 void Widget::resize (const BUtilities::Point<> extends)
 {
 	Visualizable::resize (extends);
+	if (getMainWindow()) getMainWindow()->updateHitIndex (this);
 }
 
 void Widget::moveTo (const double x, const double y) {moveTo (BUtilities::Point<> (x, y));}
@@ -477,6 +568,9 @@ void Widget::moveTo (const BUtilities::Point<>& position)
 	if ((position_.x != position.x) || (position_.y != position.y))
 	{
 		position_ = position;
+		invalidateTreeCache ();
+		if (getMainWindow()) getMainWindow()->updateHitIndex (this);
+		invalidateCacheGroups ();
 		if (isVisible () && getParentWidget()) getParentWidget()->emitExposeEvent ();
 	}
 }
@@ -530,9 +624,8 @@ BUtilities::Area<> Widget::getArea () const
 
 BUtilities::Point<> Widget::getAbsolutePosition () const
 {
-	BUtilities::Point<> p = BUtilities::Point<> (0, 0);
-	for (const Widget* w = this; w->getParentWidget(); w = w->getParentWidget()) p += w->getPosition();
-	return p;
+	validateTreeCache ();
+	return treeCache_.absolutePosition;
 }
 
 BUtilities::Area<> Widget::getAbsoluteArea () const
@@ -544,7 +637,7 @@ BUtilities::Area<> Widget::getAbsoluteArea () const
 
 double Widget::getXOffset () const
 {
-	if (style_.contains (BUtilities::Urid::urid (BSTYLES_STYLEPROPERTY_BORDER_URI)))
+	if (getStyle().contains (BSTYLES_STYLEPROPERTY_BORDER_URID))
 	{
 		BStyles::Border border = getBorder();
 		return border.margin + border.line.width + border.padding;
@@ -578,8 +671,9 @@ void Widget::setStatus (const BStyles::Status status)
 {
 	if (status != status_)
 	{
+		const BUtilities::Area<> a0 = getDependentArea (DrawDependency::status);
 		status_ = status;
-		update ();
+		updateArea (DrawDependency::status, a0);
 	}
 }
 
@@ -634,7 +728,12 @@ inline void Widget::leave ()
 
 void Widget::setStacking (const Widget::StackingType stacking) 
 {
-	stacking_ = stacking;
+	if (stacking != stacking_)
+	{
+		stacking_ = stacking;
+		if (getMainWindow()) getMainWindow()->updateHitIndex (this);
+		invalidateCacheGroups ();
+	}
 }
 
 Widget::StackingType Widget::getStacking () const 
@@ -644,56 +743,79 @@ Widget::StackingType Widget::getStacking () const
 
 void Widget::setStyle (const BStyles::Style& style)
 {
-	style_ = style;
-
-	// Pass child styles to respective children
-	if (pushStyle_)
+	// Passed by the cascade (see validateStyle() ): Adopt the resolved
+	// record. The children are already marked.
+	if (cascadedStyle_ && (&style == cascadedStyle_.get()))
 	{
-		for (Linkable* c : children_)
+		if (cascadedStyle_ != style_)
 		{
-			Widget* w = dynamic_cast<Widget*>(c);
-			if (w)
-			{
-				bool changed = false;
-				// 1) Forward styles in nested styles
-				BStyles::Style::iterator it = style_.find (w->getUrid());
-				if (it != style_.end() && style_.isStyle (it)) 
-				{
-					w->setStyle (it->second.get<BStyles::Style>());
-					changed = true;
-				}
-
-				// 2) Forward styles from themes
-				for (Widget* p = w; p != nullptr; p = p->getParentWidget())
-				{
-					if (p->theme_.contains(w->urid_)) 
-					{
-						w->setStyle (p->theme_[w->urid_]);
-						changed = true;
-						break;
-					}
-				}
-
-				// 3) Don't change style, but proceed cascade
-				if (!changed) w->setStyle (w->style_);
-			}
+			style_ = cascadedStyle_;
+			++styleGeneration_;
+			styleChanged_ = true;
 		}
+		return;
 	}
+
+	// Resolve pending styles first. They are kept if not overridden.
+	StyleRecords records;
+	validateStyle (&records);
+	validateFamilyStyles (&records);
+
+	style_ = std::make_shared<BStyles::Style> (style);
+	++styleGeneration_;
+	styleStale_ = false;
+	styleChanged_ = false;
+
+	// Pass child styles to respective children. Resolved on demand.
+	if (pushStyle_) invalidateChildStyles ();
 	update();
 }
 
 void Widget::setTheme (const BStyles::Theme &theme)
 {
+	// Resolve pending styles first. They are kept if not overridden.
+	StyleRecords records;
+	validateStyle (&records);
+	validateFamilyStyles (&records);
+
 	theme_ = theme;
 
 	// Pass child styles to respective children
 	if (pushStyle_)
 	{
-		if (theme_.contains (urid_)) setStyle (theme_[urid_]);
-		else setStyle (style_);	// No change, only to start the setStyle() cascade.
+		BStyles::Theme::const_iterator it = theme_.find (urid_);
+		if (it != theme_.end()) setStyle (it->second);
+		else invalidateChildStyles ();	// No change, only to start the cascade
 	}
 }
 
+const BStyles::Style& Widget::getStyle () const
+{
+	return *style_;
+}
+
+uint64_t Widget::getStyleGeneration () const
+{
+	return styleGeneration_;
+}
+
+void Widget::resolveStyles ()
+{
+	StyleRecords records;
+	validateStyle (&records);
+	validateFamilyStyles (&records);
+}
+
+BStyles::Style& Widget::getMutableStyle ()
+{
+	validateStyle ();
+	validateChildStyles ();
+	styleSources_.clear ();
+	if (style_.use_count() > 1) style_ = std::make_shared<BStyles::Style> (*style_);
+	++styleGeneration_;
+	return *style_;
+}
+
 void Widget::enablePushStyle (bool pushStyle)
 {
 	pushStyle_ = pushStyle;
@@ -701,96 +823,128 @@ void Widget::enablePushStyle (bool pushStyle)
 
 BStyles::Border Widget::getBorder() const
 {
-	return style_.getBorder();
+	return getStyle().getBorder();
 }
 
 void Widget::setBorder(const BStyles::Border& border)
 {
 	if (border != getBorder())
 	{
-		style_.setBorder (border);
+		getMutableStyle().setBorder (border);
 		update();
 	}
 }
 
 BStyles::Fill Widget::getBackground() const
 {
-    return style_.getBackground();
+    return getStyle().getBackground();
 }
 
 void Widget::setBackground(const BStyles::Fill& fill)
 {
     if (fill != getBackground())
 	{
-		style_.setBackground(fill);
+		getMutableStyle().setBackground (fill);
 		update();
 	}
 }
 
 BStyles::Font Widget::getFont() const
 {
-    return style_.getFont();
+    return getStyle().getFont();
 }
 
 void Widget::setFont(const BStyles::Font& font)
 {
     if (font != getFont())
 	{
-		style_.setFont(font);
+		getMutableStyle().setFont (font);
 		update();
 	}
 }
 
 BStyles::ColorMap Widget::getFgColors() const
 {
-    return style_.getFgColors();
+    return getStyle().getFgColors();
 }
 
 void Widget::setFgColors (const BStyles::ColorMap& colors)
 {
     if (colors != getFgColors())
 	{
-		style_.setFgColors(colors);
+		getMutableStyle().setFgColors (colors);
 		update();
 	}
 }
 
 BStyles::ColorMap Widget::getBgColors() const
 {
-    return style_.getBgColors();
+    return getStyle().getBgColors();
 }
 
 void Widget::setBgColors (const BStyles::ColorMap& colors)
 {
     if (colors != getBgColors())
 	{
-		style_.setBgColors(colors);
+		getMutableStyle().setBgColors (colors);
 		update();
 	}
 }
 
 BStyles::ColorMap Widget::getTxColors() const
 {
-    return style_.getTxColors();
+    return getStyle().getTxColors();
 }
 
 void Widget::setTxColors (const BStyles::ColorMap& colors)
 {
     if (colors != getTxColors())
 	{
-		style_.setTxColors(colors);
+		getMutableStyle().setTxColors (colors);
 		update();
 	}
 }
 
-int Widget::getLayer () const
+void Widget::setLayer (const int layer)
+{
+	if (layer != Visualizable::getLayer())
+	{
+		Visualizable::setLayer (layer);
+		invalidateTreeCache ();
+		if (getMainWindow()) getMainWindow()->invalidateHitIndex();
+		invalidateCacheGroups ();
+	}
+}
+
+void Widget::setOpaque (const bool status)
+{
+	if (status != isOpaque())
+	{
+		Visualizable::setOpaque (status);
+		if (getMainWindow()) getMainWindow()->invalidateHitIndex();
+	}
+}
+
+void Widget::setCacheGroup (const bool status)
 {
-	for (const Widget* w = this; w != nullptr; w = w->getParentWidget())
+	if (status != cacheGroup_)
 	{
-		if (w->layer_ != BWIDGETS_UNDEFINED_LAYER) return w->layer_;
+		cacheGroup_ = status;
+		cacheGroupValid_ = false;
+		releaseCacheGroup ();
 	}
+}
 
-	return BWIDGETS_UNDEFINED_LAYER;
+bool Widget::isCacheGroup () const
+{
+	return cacheGroup_;
+}
+
+int Widget::getLayer () const
+{
+	if (layer_ != BWIDGETS_UNDEFINED_LAYER) return layer_;
+	validateTreeCache ();
+	return treeCache_.layer;
 }
 
 void Widget::setFocusText (std::function<std::string (const Widget* widget)> func)
@@ -811,9 +965,12 @@ std::string Widget::getFocusText () const
 
 void Widget::emitExposeEvent ()
 {
-	BUtilities::Area<> area = getFamilyArea ([] (const Widget* w) {return w->isVisible();});
-	area.moveTo (getAbsolutePosition ());
-	emitExposeEvent (area);
+	// Validating styles: Already covered by the family area of a parent
+	const Window* main = getMainWindow();
+	if (main && main->stylesValidating_ && main->styleExposeCovered_) return;
+
+	// Absolute family area: also covers escaping children left or above
+	emitExposeEvent (getAbsoluteFamilyArea ([] (const Widget* w) {return w->isVisible();}));
 }
 
 void Widget::emitExposeEvent (const BUtilities::Area<>& area)
@@ -821,7 +978,15 @@ void Widget::emitExposeEvent (const BUtilities::Area<>& area)
 	Window* main = getMainWindow();
 	if (main)
 	{
-		BEvents::ExposeEvent* event = new BEvents::ExposeEvent (main, this, BEvents::Event::EventType::exposeRequestEvent, area);
+		// Validating styles: Collect into a single expose request
+		if (main->stylesValidating_)
+		{
+			if (main->styleExposeArea_ == BUtilities::Area<> ()) main->styleExposeArea_ = area;
+			else main->styleExposeArea_.extend (area);
+			return;
+		}
+
+		BEvents::ExposeEvent* event = main->createEvent<BEvents::ExposeEvent> (main, this, BEvents::Event::EventType::exposeRequestEvent, area);
 		main->addEventToQueue (event);
 	}
 }
@@ -910,6 +1075,27 @@ Widget* Widget::getWidgetAt	(const BUtilities::Point<>& abspos,
 	else return nullptr;
 }
 
+Visualizable::SurfaceList* Widget::getSurfaceList () const
+{
+	Window* main = getMainWindow();
+	return (main ? &main->surfaceList_ : nullptr);
+}
+
+size_t Widget::getFamilySurfaceBytes () const
+{
+	size_t bytes = getSurfaceBytes();
+	forEachChild
+	(
+		[&bytes] (Linkable* l)
+		{
+			Widget* w = dynamic_cast<Widget*> (l);
+			if (w) bytes += w->getSurfaceBytes();
+			return true;
+		}
+	);
+	return bytes;
+}
+
 BUtilities::Area<> Widget::getFamilyArea (std::function<bool (const Widget* widget)> func) const
 {
 	BUtilities::Area<> a = getAbsoluteFamilyArea (func);
@@ -945,11 +1131,16 @@ void Widget::display (std::map<int, cairo_surface_t*>& surfaces, const BUtilitie
 		// Calculate absolute area position and start private core method
 		BUtilities::Area<> absArea = area;
 		absArea.moveTo (absArea.getPosition() + getAbsolutePosition());
-		display (surfaces, surfaceExtends, absArea, absArea);
+		display (surfaces, surfaceExtends, getScale(), absArea, absArea);
 	}
 }
 
-void Widget::display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const BUtilities::Area<>& outerArea, const BUtilities::Area<>& area)
+void Widget::display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const BUtilities::Region<>& region)
+{
+	for (const BUtilities::Area<>& a : region) display (surfaces, surfaceExtends, a);
+}
+
+void Widget::display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const double scale, const BUtilities::Area<>& outerArea, const BUtilities::Area<>& area, const Widget* group)
 {
 	BUtilities::Area<> a = (getStacking() == StackingType::escape ? outerArea : area);
 	BUtilities::Area<> thisArea = getArea(); 
@@ -957,33 +1148,319 @@ void Widget::display (std::map<int, cairo_surface_t*>& surfaces, const BUtilitie
 	a.intersect (thisArea);
 	if (isVisible())
 	{
-		if (a != BUtilities::Area<> ())
+		Window* main = getMainWindow();
+
+		// Cache group: Copy the cached composite of the whole family. Don't 
+		// cull while rendering a cache group.
+		if (cacheGroup_ && (group != this) && validateCacheGroup (scale))
+		{
+			if ((a != BUtilities::Area<> ()) && (group || (!main) || (!main->isOccluded (this, a, true))))
+			{
+				if (surfaces.find(getLayer()) == surfaces.end()) 
+				{
+					surfaces[getLayer()] = createSurface (surfaceExtends, scale);
+				}
+
+				cairo_surface_t* s = surfaces[getLayer()];
+				if (!cairoplus_surface_paint_area (s, a.getX (), a.getY (), a.getWidth (), a.getHeight (), cacheGroupSurface_, thisArea.getX(), thisArea.getY()))
+				{
+					cairo_t* cr = cairo_create (s);
+					cairo_rectangle (cr, a.getX (), a.getY (), a.getWidth (), a.getHeight ());
+					cairo_translate (cr, thisArea.getX(), thisArea.getY());
+					cairo_set_source_surface (cr, cacheGroupSurface_, 0, 0);
+					cairo_fill (cr);
+					cairo_destroy (cr);
+				}
+			}
+			return;
+		}
+
+		const bool preview = isPreviewed();
+		if ((a != BUtilities::Area<> ()) && (group || (!main) || (!main->isOccluded (this, a))) && (preview || validateSurface ()))
 		{
 			// Update draw
-			if (scheduleDraw_) draw ();
+			if ((!preview) && isDrawScheduled()) redraw ();
 
 			// Copy widgets surface onto the map of layered surfaces
 			if (surfaces.find(getLayer()) == surfaces.end()) 
 			{
-				surfaces[getLayer()] = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, surfaceExtends.x, surfaceExtends.y);
+				surfaces[getLayer()] = createSurface (surfaceExtends, scale);
 			}
 
+			// Compose pixels directly if possible, otherwise use Cairo
 			cairo_surface_t* s =  surfaces[getLayer()];
-			cairo_t* cr = cairo_create (s);
-			cairo_set_source_surface (cr, cairoSurface(), thisArea.getX(), thisArea.getY());
-			cairo_rectangle (cr, a.getX (), a.getY (), a.getWidth (), a.getHeight ());
-			cairo_fill (cr);
-			cairo_destroy (cr);
+			if (preview || (!cairoplus_surface_paint_area (s, a.getX (), a.getY (), a.getWidth (), a.getHeight (), cairoSurface(), thisArea.getX(), thisArea.getY())))
+			{
+				cairo_t* cr = cairo_create (s);
+				cairo_rectangle (cr, a.getX (), a.getY (), a.getWidth (), a.getHeight ());
+				cairo_translate (cr, thisArea.getX(), thisArea.getY());
+				if (preview)
+				{
+					// Stretch previous content to the new extends
+					const BUtilities::Point<> de = getDrawnExtends();
+					cairo_scale (cr, getWidth() / de.x, getHeight() / de.y);
+				}
+				cairo_set_source_surface (cr, cairoSurface(), 0, 0);
+				cairo_fill (cr);
+				cairo_destroy (cr);
+			}
 		}
 
 		for (Linkable* l : children_)
 		{
 			Widget* w = dynamic_cast<Widget*> (l);
-			if (w) w->display (surfaces, surfaceExtends, outerArea, a);
+			if (w) w->display (surfaces, surfaceExtends, scale, outerArea, a, group);
 		}
 	}
 }
 
+void Widget::validateTreeCache () const
+{
+	const uint64_t generation = getTreeGeneration ();
+	if (treeCache_.generation == generation) return;
+
+	// Derive from the (cached) properties of the parent
+	Widget* parent = dynamic_cast<Widget*> (getParent());
+	Window* main = dynamic_cast<Window*> (getMain());
+	treeCache_.parent = parent;
+	treeCache_.main = main;
+	treeCache_.absolutePosition = (parent ? parent->getAbsolutePosition() + position_ : BUtilities::Point<> (0, 0));
+	treeCache_.layer = (parent ? parent->getLayer() : BWIDGETS_UNDEFINED_LAYER);
+	treeCache_.visible = (main == this) || (main && parent && parent->isVisible());
+	treeCache_.generation = generation;
+}
+
+void Widget::invalidateTreeCache ()
+{
+	invalidateTree ();
+}
+
+void Widget::validateStyle (StyleRecords* records)
+{
+	if (!styleStale_) return;
+
+	// Resolve top-down: parent first
+	Widget* parent = getParentWidget ();
+	if (parent) parent->validateStyle (records);
+	styleStale_ = false;
+	styleSources_.clear ();
+	if (!parent) return;
+
+	// Theme, starting with this widget
+	std::shared_ptr<BStyles::Style> theme = nullptr;
+	for (const Widget* p = this; p != nullptr; p = p->getParentWidget())
+	{
+		BStyles::Theme::const_iterator t = p->theme_.find (urid_);
+		if (t != p->theme_.end())
+		{
+			// Share one record per theme style
+			if (records)
+			{
+				std::shared_ptr<BStyles::Style>& record = (*records)[&t->second];
+				if (!record) record = std::make_shared<BStyles::Style> (t->second);
+				theme = record;
+			}
+			else theme = std::make_shared<BStyles::Style> (t->second);
+			break;
+		}
+	}
+
+	// Apply all styles received by the parent in the same cascade in order
+	// (otherwise the parent style). Nested styles of previously received 
+	// styles are kept if not overridden. The received styles are stored for
+	// the children.
+	const bool cascaded = (parent->styleCascade_ == styleCascade_) && (!parent->styleSources_.empty());
+	const size_t nrSources = (cascaded ? parent->styleSources_.size() : 1);
+	std::shared_ptr<const BStyles::Style> style = style_;
+	auto receive = [this] (const std::shared_ptr<const BStyles::Style>& s)
+	{
+		if (styleSources_.empty() || (styleSources_.back() != s)) styleSources_.push_back (s);
+	};
+
+	for (size_t i = 0; i < nrSources; ++i)
+	{
+		const std::shared_ptr<const BStyles::Style> source = (cascaded ? parent->styleSources_[i] : parent->style_);
+
+		// 1) Nested style, shares the record of the source
+		BStyles::Style::const_iterator it = source->find (urid_);
+		if ((it != source->end()) && source->isStyle (it))
+		{
+			style = std::shared_ptr<const BStyles::Style> (source, &it->second.get<BStyles::Style>());
+			if (theme) receive (style);
+		}
+
+		// 2) Theme
+		if (theme) style = theme;
+
+		// 3) Otherwise keep style
+		receive (style);
+	}
+
+	// Pass the resolved style to the (virtual) setStyle() of this widget
+	cascadedStyle_ = std::const_pointer_cast<BStyles::Style> (style);
+	setStyle (*style);
+	cascadedStyle_ = nullptr;
+}
+
+void Widget::invalidateStyle ()
+{
+	markStyleStale (++styleCascades_);
+	scheduleStyles ();
+}
+
+void Widget::invalidateChildStyles ()
+{
+	const uint64_t cascade = ++styleCascades_;
+	for (Linkable* c : children_)
+	{
+		Widget* w = dynamic_cast<Widget*> (c);
+		if (w) w->markStyleStale (cascade);
+	}
+
+	scheduleStyles ();
+}
+
+void Widget::scheduleStyles ()
+{
+	// Resolved by the main window before the next frame. Otherwise, nobody
+	// else will: resolve now.
+	Window* main = getMainWindow ();
+	if (main) main->stylesValid_ = false;
+	else resolveStyles ();
+}
+
+void Widget::validateChildStyles ()
+{
+	for (Linkable* c : children_)
+	{
+		Widget* w = dynamic_cast<Widget*> (c);
+		if (w) w->validateStyle ();
+	}
+}
+
+void Widget::validateFamilyStyles (StyleRecords* records)
+{
+	for (Linkable* c : children_)
+	{
+		Widget* w = dynamic_cast<Widget*> (c);
+		if (w)
+		{
+			w->validateStyle (records);
+			w->validateFamilyStyles (records);
+		}
+	}
+}
+
+void Widget::markStyleStale (const uint64_t cascade)
+{
+	// Children of stale widgets are already marked
+	if (styleStale_) return;
+
+	styleStale_ = true;
+	styleCascade_ = cascade;
+	if (pushStyle_)
+	{
+		for (Linkable* c : children_)
+		{
+			Widget* w = dynamic_cast<Widget*> (c);
+			if (w) w->markStyleStale (cascade);
+		}
+	}
+}
+
+const std::shared_ptr<BStyles::Style>& Widget::emptyStyle ()
+{
+	static const std::shared_ptr<BStyles::Style> empty = std::make_shared<BStyles::Style> ();
+	return empty;
+}
+
+void Widget::invalidateCacheGroups ()
+{
+	for (Widget* w = this; w; w = w->getParentWidget()) w->cacheGroupValid_ = false;
+}
+
+bool Widget::validateCacheGroup (const double scale)
+{
+	// Display previews directly while the main window is resized
+	const Window* main = getMainWindow();
+	if (main && main->isResizing())
+	{
+		cacheGroupValid_ = false;
+		releaseCacheGroup ();
+		return false;
+	}
+
+	if (cacheGroupValid_ && (cacheGroupScale_ == scale)) return (cacheGroupSurface_ != nullptr);
+	cacheGroupValid_ = true;
+	cacheGroupScale_ = scale;
+
+	// Only families within the same layer and without escaping children
+	const int layer = getLayer();
+	bool cacheable = true;
+	forEachChild
+	(
+		[layer, &cacheable] (Linkable* l)
+		{
+			Widget* w = dynamic_cast<Widget*> (l);
+			if ((!w) || (!w->isVisualizable())) return false;
+			if ((w->getLayer() != layer) || (w->getStacking() == StackingType::escape)) cacheable = false;
+			return cacheable;
+		}
+	);
+
+	const int width = static_cast<int> (std::ceil (getWidth() * scale));
+	const int height = static_cast<int> (std::ceil (getHeight() * scale));
+	if ((!cacheable) || (width <= 0) || (height <= 0))
+	{
+		releaseCacheGroup ();
+		return false;
+	}
+
+	// Re-use the surface if it matches the pool bucket
+	if
+	(
+		cacheGroupSurface_ &&
+		(
+			(cairo_image_surface_get_width (cacheGroupSurface_) != BUtilities::SurfacePool::getBucketSize (width)) ||
+			(cairo_image_surface_get_height (cacheGroupSurface_) != BUtilities::SurfacePool::getBucketSize (height))
+		)
+	) releaseCacheGroup ();
+
+	if (cacheGroupSurface_) cairoplus_surface_clear (cacheGroupSurface_);
+	else cacheGroupSurface_ = getSurfacePool().acquire (CAIRO_FORMAT_ARGB32, width, height);
+
+	if (cairo_surface_status (cacheGroupSurface_) != CAIRO_STATUS_SUCCESS)
+	{
+		releaseCacheGroup ();
+		return false;
+	}
+
+	// Render the family at absolute coordinates into the cache surface
+	const BUtilities::Point<> p = getAbsolutePosition();
+	const BUtilities::Area<> a = getAbsoluteArea();
+	std::map<int, cairo_surface_t*> surfaces {{layer, cacheGroupSurface_}};
+	cairo_surface_set_device_scale (cacheGroupSurface_, scale, scale);
+	cairo_surface_set_device_offset (cacheGroupSurface_, -p.x * scale, -p.y * scale);
+	display (surfaces, getExtends(), scale, a, a, this);
+	cairo_surface_set_device_offset (cacheGroupSurface_, 0.0, 0.0);
+	cairo_surface_flush (cacheGroupSurface_);
+	return true;
+}
+
+void Widget::releaseCacheGroup ()
+{
+	if (cacheGroupSurface_) getSurfacePool().release (cacheGroupSurface_);
+	cacheGroupSurface_ = nullptr;
+}
+
+bool Widget::isPreviewed () const
+{
+	if ((!scheduleDraw_) || (!cairoSurface()) || (getDrawnExtends() == getExtends())) return false;
+	if ((getDrawnExtends().x <= 0.0) || (getDrawnExtends().y <= 0.0)) return false;
+	const Window* main = getMainWindow();
+	return (main && main->isResizing());
+}
+
 void Widget::draw ()
 {
 	draw (0, 0, getWidth(), getHeight());
@@ -999,7 +1476,6 @@ void Widget::draw (const BUtilities::Area<>& area)
 	Visualizable::draw (area);
 
 	if ((!cairoSurface()) || (cairo_surface_status (cairoSurface()) != CAIRO_STATUS_SUCCESS)) return;
-	cairoplus_surface_clear (cairoSurface());
 	cairo_t* cr = cairo_create (cairoSurface());
 
 	if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
@@ -1010,12 +1486,46 @@ void Widget::draw (const BUtilities::Area<>& area)
 
 		BStyles::Border border = getBorder();
 		BStyles::Fill background = getBackground();
-
-		// Draw background
 		double innerBorders = getXOffset ();
 		double innerRadius = (border.radius > border.padding ? border.radius - border.padding : 0);
+		const bool hasBackground = (getEffectiveWidth () > 0) && (getEffectiveHeight () > 0);
+		const BUtilities::Area<> backgroundArea = BUtilities::Area<> (innerBorders, innerBorders, getEffectiveWidth (), getEffectiveHeight ());
+
+		// Solid rectangular backgrounds are written directly to the pixels
+		// if they match full pixels. Replaces clearing if the background
+		// covers the drawing area.
+		const bool solidBackground = hasBackground && (innerRadius == 0.0) && background.isColor ();
+		const uint32_t backgroundPixel = (solidBackground ? cairoplus_pixel_from_rgba (CAIRO_RGBA (background.getColor ())) : 0);
+		bool backgroundDrawn = 
+		(
+			solidBackground && 
+			backgroundArea.includes (area) &&
+			cairoplus_surface_fill_area (cairoSurface(), area.getX (), area.getY (), area.getWidth (), area.getHeight (), backgroundPixel)
+		);
+
+		// Clear drawing area only. Directly if it matches full pixels.
+		if ((!backgroundDrawn) && (!cairoplus_surface_clear_area (cairoSurface(), area.getX (), area.getY (), area.getWidth (), area.getHeight ())))
+		{
+			cairo_save (cr);
+			cairo_set_source_rgba (cr, 0.0, 0.0, 0.0, 0.0);
+			cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+			cairo_paint (cr);
+			cairo_restore (cr);
+		}
+
+		// Draw background
+		if (hasBackground && (!backgroundDrawn))
+		{
+			BUtilities::Area<> a = backgroundArea;
+			a.intersect (area);
+			backgroundDrawn = 
+			(
+				solidBackground &&
+				cairoplus_surface_fill_area (cairoSurface(), a.getX (), a.getY (), a.getWidth (), a.getHeight (), backgroundPixel)
+			);
+		}
 
-		if ((getEffectiveWidth () > 0) && (getEffectiveHeight () > 0))
+		if (hasBackground && (!backgroundDrawn))
 		{
 			background.setCairoSource (cr);
 			
@@ -1050,18 +1560,61 @@ void Widget::draw (const BUtilities::Area<>& area)
 		)
 		{
 			double lw = border.line.width;
-			cairoplus_rectangle_rounded
+
+			// Solid rectangular frames outside the background are written
+			// directly to the (cleared) pixels if they match full pixels
+			bool frameDrawn = false;
+			if
 			(
-				cr,
-				outerBorders + lw / 2,
-				outerBorders + lw / 2,
-				getWidth () - 2 * outerBorders - lw,
-				getHeight () - 2 * outerBorders - lw,
-				border.radius, 0b1111);
-
-			cairo_set_source_rgba (cr, CAIRO_RGBA (lc));
-			cairo_set_line_width (cr, lw);
-			cairo_stroke (cr);
+				(border.radius == 0.0) &&
+				(lw > 0.0) &&
+				(innerBorders >= outerBorders + lw) &&
+				(getWidth () >= 2 * (outerBorders + lw)) &&
+				(getHeight () >= 2 * (outerBorders + lw))
+			)
+			{
+				const double w = getWidth () - 2 * outerBorders;
+				const double h = getHeight () - 2 * outerBorders;
+				BUtilities::Area<> frame[4] =
+				{
+					BUtilities::Area<> (outerBorders, outerBorders, w, lw),
+					BUtilities::Area<> (outerBorders, getHeight () - outerBorders - lw, w, lw),
+					BUtilities::Area<> (outerBorders, outerBorders + lw, lw, h - 2 * lw),
+					BUtilities::Area<> (getWidth () - outerBorders - lw, outerBorders + lw, lw, h - 2 * lw)
+				};
+
+				frameDrawn = true;
+				for (BUtilities::Area<>& f : frame)
+				{
+					f.intersect (area);
+					frameDrawn = frameDrawn && cairoplus_surface_area_is_pixel_aligned (cairoSurface(), f.getX (), f.getY (), f.getWidth (), f.getHeight ());
+				}
+
+				if (frameDrawn)
+				{
+					const uint32_t pixel = cairoplus_pixel_from_rgba (CAIRO_RGBA (lc));
+					for (const BUtilities::Area<>& f : frame)
+					{
+						cairoplus_surface_fill_area (cairoSurface(), f.getX (), f.getY (), f.getWidth (), f.getHeight (), pixel);
+					}
+				}
+			}
+
+			if (!frameDrawn)
+			{
+				cairoplus_rectangle_rounded
+				(
+					cr,
+					outerBorders + lw / 2,
+					outerBorders + lw / 2,
+					getWidth () - 2 * outerBorders - lw,
+					getHeight () - 2 * outerBorders - lw,
+					border.radius, 0b1111);
+
+				cairo_set_source_rgba (cr, CAIRO_RGBA (lc));
+				cairo_set_line_width (cr, lw);
+				cairo_stroke (cr);
+			}
 		}
 	}
 
@@ -18,13 +18,19 @@
 #ifndef BWIDGETS_WIDGET_HPP_
 #define BWIDGETS_WIDGET_HPP_
 
+#include <atomic>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <set>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "Draws/Ergo/definitions.hpp"
 #include "../BDevices/Device.hpp"
+#include "../BDevices/DeviceTable.hpp"
 #include "../BUtilities/Dictionary.hpp"
+#include "../BUtilities/Region.hpp"
 #include "Supports/Linkable.hpp"
 #include "Supports/Visualizable.hpp"
 #include "Supports/EventMergeable.hpp"
@@ -106,6 +112,23 @@ class Widget :	public Linkable,
 				public Activatable,
 				public Enterable
 {
+	friend class Window;
+
+public:
+
+	/**
+	 *  @brief  State properties which the %Widget visualization depends on.
+	 *
+	 *  See @c getDependentArea() . @c layout is the geometry the other
+	 *  dependent areas are computed from (e. g., the scale of a slider).
+	 */
+	enum class DrawDependency
+	{
+		value,
+		status,
+		text,
+		layout
+	};
 
 protected:
 
@@ -131,12 +154,46 @@ protected:
 	StackingType stacking_;
 	BStyles::Status status_;
 	std::string title_;
-	BStyles::Style style_;
 	BStyles::Theme theme_;
 	Widget* focus_;
 	std::function<std::string (const Widget* widget)> focusTextFunction_;
 	bool pushStyle_;
-	std::set<BDevices::Device*> devices_;
+	BDevices::DeviceTable devices_;
+
+private:
+	bool partialUpdate_;
+	BUtilities::Area<> partialArea_;
+	bool partialDependent_;
+	DrawDependency partialDependency_;
+	BUtilities::Area<> partialLayout_;
+	bool cacheGroup_;
+	bool cacheGroupValid_;
+	double cacheGroupScale_;
+	cairo_surface_t* cacheGroupSurface_;
+
+	struct TreeCache
+	{
+		uint64_t generation;
+		Widget* parent;
+		Window* main;
+		BUtilities::Point<> absolutePosition;
+		int layer;
+		bool visible;
+	};
+
+	mutable TreeCache treeCache_;
+
+	typedef std::unordered_map<const BStyles::Style*, std::shared_ptr<BStyles::Style>> StyleRecords;
+	typedef std::vector<std::shared_ptr<const BStyles::Style>> StyleSources;
+
+	std::shared_ptr<BStyles::Style> style_;
+	StyleSources styleSources_;
+	uint64_t styleGeneration_;
+	uint64_t styleCascade_;
+	static inline std::atomic<uint64_t> styleCascades_ {0};
+	bool styleStale_;
+	bool styleChanged_;
+	std::shared_ptr<BStyles::Style> cascadedStyle_;
 
 public:
 
@@ -250,6 +307,10 @@ public:
 	 * @brief  Takes control over a device. 
 	 * 
 	 * @param device  Device.
+	 *
+	 * Stores a copy of @a device. Replaces an equal device object if 
+	 * already grabbed. Also registers the grab in the main %Window (see
+	 * @c Window::listDeviceGrabbed() ).
 	 */
 	virtual void grabDevice (const BDevices::Device& device);
 
@@ -308,6 +369,11 @@ public:
 	 *
 	 *  Returns @c nullptr if the widget isn't connected to a main window.
 	 *  Returns a pointer to itself if the widget is the main window itself.
+	 *
+	 *  The parent, the main window, the visibility, the absolute position,
+	 *  and the layer of a %Widget are cached. All caches are invalidated
+	 *  upon changes of the widget tree ( @c moveTo() , @c show() , 
+	 *  @c hide() , @c setLayer() , @c add() , @c release() ).
 	 */
 	Window* getMainWindow () const;
 
@@ -356,6 +422,47 @@ public:
      */
     virtual void update () override;
 
+	/**
+	 *  @brief  Method to be called following an object state change which
+	 *  only affects a part of the %Widget.
+	 *  @param area  Affected area relative to the %Widget origin.
+	 *
+	 *  Calls @c update() , but only schedules a redraw and redisplay of
+	 *  @a area. Only the damaged area is cleared and redrawn.
+	 */
+	void updateArea (const BUtilities::Area<>& area);
+
+	/**
+	 *  @brief  Method to be called following a state property change which
+	 *  only affects a part of the %Widget.
+	 *  @param dependency  Changed state property.
+	 *  @param area  Dependent area before the change relative to the 
+	 *  %Widget origin.
+	 *
+	 *  Same as @c updateArea() for @a area plus the dependent area after 
+	 *  the change. The dependent area after the change is taken once 
+	 *  @c update() has re-run the layout. Performs a full update if the
+	 *  layout (see @c getDependentArea() ) changed.
+	 */
+	void updateArea (const DrawDependency dependency, const BUtilities::Area<>& area);
+
+	/**
+	 *  @brief  Gets the area of the %Widget which depends on a state 
+	 *  property.
+	 *  @param dependency  State property (value, status, text, or layout).
+	 *  @return  Area relative to the %Widget origin.
+	 *
+	 *  Changes of the value (see @c ValueableTyped::setValue() ), the status
+	 *  (see @c setStatus() ), or the text (see @c Label::setText() ) only
+	 *  redraw the dependent areas before and after the change. Default is
+	 *  the whole %Widget area. Widgets with locally changing content (e. g.,
+	 *  the knob of a slider) override this method. If their dependent areas
+	 *  are computed from a layout which may change with the state (e. g.,
+	 *  the scale of a slider which makes room for a value label), they also
+	 *  return this layout area for @c DrawDependency::layout .
+	 */
+	virtual BUtilities::Area<> getDependentArea (const DrawDependency dependency) const;
+
     /**
 	 *  @brief  Generic setter method for Supports.
 	 *  @tparam T  Type of Support.
@@ -498,6 +605,16 @@ public:
 	 */
 	BUtilities::Area<> getAbsoluteArea () const;
 
+	/**
+	 *  @brief  Gets the memory size of the surfaces of this %Widget and all
+	 *  its children.
+	 *  @return  Size in bytes of all allocated surfaces.
+	 *
+	 *  See @c Visualizable::getSurfaceBytes() for the surface of this
+	 *  %Widget only.
+	 */
+	size_t getFamilySurfaceBytes () const;
+
 	/**
 	 *  @brief  X offset of the %Widget content relative to the %Widget X 
 	 *  position.
@@ -611,17 +728,57 @@ public:
 	 *  @brief  Copies the style from another object.
 	 *  @param style  Other style.
 	 *
+	 *  Nested styles of @a style and themes are pushed to the child widgets
+	 *  (see @c enablePushStyle() ). The child widget styles are resolved by
+	 *  the main Window before its next frame (see @c resolveStyles() ). 
+	 *  Each resolved child widget style is passed to this method of the 
+	 *  child widget (as in a cascade).
+	 *
 	 *  Composite widgets should override this method to forward the passed
-	 *  @a style to embedded child widgets too.
+	 *  @a style to embedded child widgets too. Overriding methods must call
+	 *  @c Widget::setStyle() with the passed @a style.
 	 */
 	virtual void setStyle (const BStyles::Style& style);
 
 	/**
 	 *  @brief  Copies the theme from another object.
 	 *  @param theme  Other theme.
+	 *
+	 *  Sets the style of this %Widget to the style of the theme for its URID
+	 *  (if exists) and pushes the theme to the child widgets (see 
+	 *  @c setStyle() ).
 	 */
 	virtual void setTheme (const BStyles::Theme& theme);
 
+	/**
+	 *  @brief  Gets the style of this %Widget.
+	 *  @return  Reference to the last resolved style. Only valid until the 
+	 *  style of this %Widget changes.
+	 *
+	 *  Doesn't resolve styles pushed to this %Widget (see 
+	 *  @c resolveStyles() ). Resolved styles from the same source (nested
+	 *  style or theme) may be shared by multiple widgets.
+	 */
+	const BStyles::Style& getStyle () const;
+
+	/**
+	 *  @brief  Gets the generation number of the style of this %Widget.
+	 *  @return  Generation number. Changes each time the resolved style of
+	 *  this %Widget changes.
+	 */
+	uint64_t getStyleGeneration () const;
+
+	/**
+	 *  @brief  Resolves the styles pushed to this %Widget and its children.
+	 *
+	 *  Styles pushed by @c setStyle() , @c setTheme() or @c add() are 
+	 *  resolved by the main Window before its next frame, or right away if
+	 *  the widgets are not linked to a main Window. Call this method to read
+	 *  the resolved styles (e.g., by @c getStyle() ) before. Calls 
+	 *  @c setStyle() of each widget with a pushed style.
+	 */
+	void resolveStyles ();
+
 	/**
 	 *  @brief  Enables pushing styles to child widgets on @c add() or
 	 *  @c setStyle() or @c setTheme(). 
@@ -737,6 +894,50 @@ public:
      */
     virtual void setTxColors (const BStyles::ColorMap& colors);
 
+    /**
+     *  @brief  Re-indexes the object surface.
+     *  @param layer  Layer index.
+     *
+     *  The layer index represents the Z position of the surface. The higher
+     *  the index, the more to the background. The default layer has got the
+     *  index BWIDGETS_UNDEFINED_LAYER. Lower indexed layers will be 
+     *  displayed in front of the default layer, higher indexed layers behind.
+     */
+    virtual void setLayer (const int layer) override;
+
+    /**
+     *  @brief  Sets the opaque hint.
+     *  @param status  True if opaque, otherwise false (default).
+     *
+     *  Opaque widgets promise to cover their whole area with fully opaque
+     *  content, e. g., a %Widget with a plain opaque background and without
+     *  rounded corners, margin, and padding. The main Window doesn't 
+     *  composite widgets (or parts of them) which are covered by opaque 
+     *  widgets in front of them.
+     */
+    virtual void setOpaque (const bool status) override;
+
+    /**
+     *  @brief  Sets the cache group flag.
+     *  @param status  True to cache the composite of this %Widget and all its
+     *  children, otherwise false (default).
+     *
+     *  The family of a cache group is flattened into one cached surface
+     *  which is displayed as a whole instead of compositing child by child.
+     *  The cache is invalidated by @c update() , @c moveTo() , @c show() , 
+     *  @c hide() , restyling, or re-stacking of this %Widget or any of its
+     *  children. Useful for large, mostly static containers (e. g., a Frame
+     *  with many labels). Families containing children of other layers or
+     *  escaping children are not cached.
+     */
+    void setCacheGroup (const bool status);
+
+    /**
+     *  @brief  Gets the cache group flag.
+     *  @return  True if this %Widget is a cache group, otherwise false.
+     */
+    bool isCacheGroup () const;
+
     /**
      *  @brief  Gets the object surface.
      *  @param layer  Layer index.
@@ -810,6 +1011,21 @@ public:
 
 protected:
 
+	/**
+	 *  @brief  Gets the style of this %Widget for changing it.
+	 *  @return  Reference to the style. Only valid until the style of this
+	 *  %Widget changes.
+	 *
+	 *  Copy-on-write: Gets an own copy of a shared style first. Increments
+	 *  the style generation number.
+	 *
+	 *  Replaces the direct access to the protected member @a style_ of 
+	 *  previous versions (API change). Derived classes read the style with
+	 *  @c getStyle() and change it with @c getMutableStyle() followed by
+	 *  @c update().
+	 */
+	BStyles::Style& getMutableStyle ();
+
 	/**
 	 *  @brief  Gets the area covered by this %Widget and all its children.
 	 *  @param func  Optional, filter function.
@@ -838,16 +1054,17 @@ protected:
 	 *     (false), then
 	 *  3. checks if the filter function @a func returns true.
 	 */
-	Widget* getWidgetAt	(const BUtilities::Point<>& position, 
-						 std::function<bool (Widget* widget)> func = [] (Widget* widget) {return true;},
-						 std::function<bool (Widget* widget)> passfunc = [] (Widget* widget) {return false;});
+	virtual Widget* getWidgetAt	(const BUtilities::Point<>& position, 
+								 std::function<bool (Widget* widget)> func = [] (Widget* widget) {return true;},
+								 std::function<bool (Widget* widget)> passfunc = [] (Widget* widget) {return false;});
 
 	/**
 	 *  @brief  Draws %Widget surface and children surfaces to the provided
 	 *  map of layered target surfaces.
 	 *  @param surfaces  Map of target surfaces.
 	 *  @param surfaceExtends  Extends of the surfaces to be created for each
-	 *  layer.
+	 *  layer. The surfaces are created at the device scale of this %Widget
+	 *  (see @c getScale() ).
 	 *  @param area  Clipping area.
 	 *
 	 *  This method is called by the main Window system event handler upon an
@@ -858,6 +1075,19 @@ protected:
 	 */
 	virtual void display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const BUtilities::Area<>& area);
 
+	/**
+	 *  @brief  Draws %Widget surface and children surfaces to the provided
+	 *  map of layered target surfaces.
+	 *  @param surfaces  Map of target surfaces.
+	 *  @param surfaceExtends  Extends of the surfaces to be created for each
+	 *  layer.
+	 *  @param region  Clipping region. Its areas must not overlap.
+	 *
+	 *  Same as @c display() for an area, but only draws the areas of 
+	 *  @a region .
+	 */
+	void display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const BUtilities::Region<>& region);
+
 	/**
      *  @brief  Unclipped draw a %Widget to the surface.
      */
@@ -878,8 +1108,50 @@ protected:
      */
     virtual void draw (const BUtilities::Area<>& area) override;
 
+	/**
+	 *  @brief  Gets the least recently used surface list of the main 
+	 *  Window.
+	 *  @return  Pointer to the list or nullptr if not linked to a main
+	 *  Window.
+	 */
+	virtual SurfaceList* getSurfaceList () const override;
+
 private:
-	void display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const BUtilities::Area<>& outerArea, const BUtilities::Area<>& area);
+	void display (std::map<int, cairo_surface_t*>& surfaces, const BUtilities::Point<> surfaceExtends, const double scale, const BUtilities::Area<>& outerArea, const BUtilities::Area<>& area, const Widget* group = nullptr);
+
+	/**
+	 *  @brief  Information whether the %Widget is displayed as a scaled
+	 *  preview of its previous surface content.
+	 *  @return  True if the main Window is resizing and this %Widget has
+	 *  been resized since its last draw, otherwise false.
+	 */
+	bool isPreviewed () const;
+
+	void invalidateCacheGroups ();
+
+	void validateTreeCache () const;
+
+	void invalidateTreeCache ();
+
+	void validateStyle (StyleRecords* records = nullptr);
+
+	void invalidateStyle ();
+
+	void invalidateChildStyles ();
+
+	void scheduleStyles ();
+
+	void validateChildStyles ();
+
+	void validateFamilyStyles (StyleRecords* records = nullptr);
+
+	void markStyleStale (const uint64_t cascade);
+
+	static const std::shared_ptr<BStyles::Style>& emptyStyle ();
+
+	bool validateCacheGroup (const double scale);
+
+	void releaseCacheGroup ();
 
 	Widget* getWidgetAt	(const BUtilities::Point<>& abspos, 
 						 const BUtilities::Area<>& outerArea,
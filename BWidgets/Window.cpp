@@ -22,8 +22,12 @@
 #include <cairo/cairo.h>
 #include "pugl/cairo.h"
 #include "pugl/pugl.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <cstdio>
 #include <list>
+#include <thread>
 #ifdef PKG_HAVE_FONTCONFIG
 #include <fontconfig/fontconfig.h>
 #endif /*PKG_HAVE_FONTCONFIG*/
@@ -59,6 +63,14 @@ Window::Window (const uint32_t urid, const std::string& title) :
 Window::Window (const double width, const double height, PuglNativeView nativeWindow, 
 				uint32_t urid, std::string title, bool resizable,
 				PuglWorldType worldType, int worldFlag) :
+		Window (width, height, nativeWindow, urid, title, resizable, worldType, worldFlag, false) {}
+
+Window::Window (const double width, const double height, Offscreen offscreen, uint32_t urid, std::string title) :
+		Window (width, height, 0, urid, title, false, PUGL_MODULE, 0, true) {}
+
+Window::Window (const double width, const double height, PuglNativeView nativeWindow, 
+				uint32_t urid, std::string title, bool resizable,
+				PuglWorldType worldType, int worldFlag, bool offscreen) :
 		Widget (0.0, 0.0, width, height, urid, title),
 		EventQueueable(),
 		Closeable(),
@@ -67,13 +79,67 @@ Window::Window (const double width, const double height, PuglNativeView nativeWi
 		worldType_ (worldType),
 		view_ (NULL), 
 		nativeWindow_ (nativeWindow),
+		offscreenSurface_ (nullptr),
+		offscreenContext_ (nullptr),
 		quit_ (false), 
 		focused_ (false), 
-		pointer_ ()
+		pointer_ (),
+		frameRate_ (BWIDGETS_DEFAULT_FRAME_RATE),
+		nextFrame_ (std::chrono::steady_clock::now()),
+		wakeup_ (std::chrono::steady_clock::time_point::max()),
+		exposeRegion_ (),
+		redisplayRegion_ (),
+		layerSurfaces_ (),
+		backSurface_ (nullptr),
+		drawPool_ (),
+		drawWidgets_ (),
+		surfaceList_ {nullptr, nullptr, 0, BWIDGETS_DEFAULT_SURFACE_BUDGET, 1, false},
+		resizing_ (false),
+		resizeTime_ (),
+		loopWakeups_ (0),
+		loopFrames_ (0),
+		loopStart_ (std::chrono::steady_clock::now()),
+		loopBlocked_ (0.0),
+		loopBusy_ (0.0),
+		deviceGrabs_ (),
+		hitEntries_ (),
+		hitEntryIndex_ (),
+		hitGrid_ (),
+		hitGridArea_ (),
+		hitGridColumns_ (0),
+		hitGridRows_ (0),
+		hitIndexValid_ (false),
+		hitIndexUpdates_ (),
+		hitOpaqueEntries_ (),
+		occlusionRest_ (),
+		occlusionNext_ (),
+		stylesValid_ (true),
+		stylesValidating_ (false),
+		styleExposeCovered_ (false),
+		styleRecords_ (),
+		styleExposeArea_ (),
+		inbox_ (BWIDGETS_DEFAULT_INBOX_SIZE),
+		inboxUsed_ (false),
+		inboxTime_ (std::chrono::steady_clock::now()),
+		inboxPending_ (),
+		inboxProcessing_ (),
+		inboxIndex_ ()
 {
+	inboxPending_.reserve (inbox_.capacity());
+	inboxProcessing_.reserve (inbox_.capacity());
+	setDrawThreads (BWIDGETS_DEFAULT_DRAW_THREADS);
 	main_ = this;
 	layer_ = BWIDGETS_DEFAULT_WINDOW_LAYER;
 
+	// Offscreen: Compose each frame in handleEvents() into an image surface
+	if (offscreen)
+	{
+		frameRate_ = 0.0;
+		createOffscreenSurface ();
+		emitExposeEvent();
+		return;
+	}
+
 	world_ = puglNewWorld (worldType, worldFlag);
 	puglSetWorldString (world_, PUGL_CLASS_NAME, "BWidgets");
 
@@ -103,10 +169,14 @@ Window::~Window ()
 		if (w) release (w);
 	}
 	purgeEventQueue ();
-	puglFreeView (view_);
-	puglFreeWorld (world_);
+	destroyLayerSurfaces ();
+	destroyOffscreenSurface ();
+	if (view_) puglFreeView (view_);
+	if (world_) puglFreeWorld (world_);
+	setSurfaceList (nullptr);
 	main_ = nullptr;	// Important switch for the super destructor. It took
 						// days of debugging ...
+	invalidateTreeCache ();
 
 	// Cleanup debug information for memory checkers
 	// Remove if cairo may still be live at this timepoint of call.
@@ -123,59 +193,447 @@ Window::~Window ()
 void Window::freeDevice ()
 {
 	Widget::freeDevice();
-	forEachChild
-	(
-		[](Linkable* obj) 
+	for (std::pair<const uint64_t, std::vector<Widget*>>& g : deviceGrabs_)
+	{
+		while (!g.second.empty())
 		{
-			Widget* w = dynamic_cast<Widget*>(obj);
-			if (w) w->freeDevice();
-			return true;
+			Widget* w = g.second.back();
+			w->freeDevice();
+			if ((!g.second.empty()) && (g.second.back() == w)) g.second.pop_back();
 		}
-	);
+	}
 }
 
 void Window::freeDevice (const BDevices::Device &device)
 {
 	Widget::freeDevice (device);
-	forEachChild
-	(
-		[&device](Linkable* obj) 
+	std::unordered_map<uint64_t, std::vector<Widget*>>::iterator it = deviceGrabs_.find (device.getId());
+	if (it != deviceGrabs_.end())
+	{
+		while (!it->second.empty())
 		{
-			Widget* w = dynamic_cast<Widget*>(obj);
-			if (w) w->freeDevice (device);
-			return true;
+			Widget* w = it->second.back();
+			w->freeDevice (device);
+			if ((!it->second.empty()) && (it->second.back() == w)) it->second.pop_back();
 		}
-	);
+	}
 }
 
 std::list<Widget*> Window::listDeviceGrabbed (const BDevices::Device& device) const
 {
-	std::list<Widget*> widgets;
-	forEachChild
+	std::unordered_map<uint64_t, std::vector<Widget*>>::const_iterator it = deviceGrabs_.find (device.getId());
+	if (it == deviceGrabs_.cend()) return std::list<Widget*> ();
+	return std::list<Widget*> (it->second.cbegin(), it->second.cend());
+}
+
+void Window::addDeviceGrab (Widget* widget, const BDevices::Device& device)
+{
+	std::vector<Widget*>& widgets = deviceGrabs_[device.getId()];
+	if (std::find (widgets.begin(), widgets.end(), widget) == widgets.end()) widgets.push_back (widget);
+}
+
+void Window::removeDeviceGrab (Widget* widget, const BDevices::Device& device)
+{
+	// Keep empty entries to avoid re-allocation
+	std::unordered_map<uint64_t, std::vector<Widget*>>::iterator it = deviceGrabs_.find (device.getId());
+	if (it != deviceGrabs_.end())
+	{
+		std::vector<Widget*>::iterator wit = std::find (it->second.begin(), it->second.end(), widget);
+		if (wit != it->second.end()) it->second.erase (wit);
+	}
+}
+
+Widget* Window::getWidgetAt	(const BUtilities::Point<>& position, 
+							 std::function<bool (Widget* widget)> func,
+							 std::function<bool (Widget* widget)> passfunc)
+{
+	return getWidgetsAt (position, {WidgetFilter (func, passfunc)}).front();
+}
+
+std::vector<Widget*> Window::getWidgetsAt (const BUtilities::Point<>& position, const std::vector<WidgetFilter>& filters)
+{
+	std::vector<Widget*> results (filters.size(), nullptr);
+	validateHitIndex ();
+	if (hitEntries_.empty() || (hitGridColumns_ == 0) || (hitGridRows_ == 0)) return results;
+	if (!hitGridArea_.contains (position)) return results;
+
+	// Collect widgets at position (in tree order) and their parents
+	const size_t col = std::min (static_cast<size_t> ((position.x - hitGridArea_.getX()) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE), hitGridColumns_ - 1);
+	const size_t row = std::min (static_cast<size_t> ((position.y - hitGridArea_.getY()) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE), hitGridRows_ - 1);
+	std::vector<std::pair<size_t, bool>> candidates;
+	for (size_t i : hitGrid_[row * hitGridColumns_ + col])
+	{
+		if (hitEntries_[i].area.contains (position)) 
+		{
+			for (size_t p = hitEntries_[i].parent; p != SIZE_MAX; p = hitEntries_[p].parent) candidates.push_back (std::make_pair (p, false));
+			candidates.push_back (std::make_pair (i, true));
+		}
+	}
+
+	if (candidates.empty()) return results;
+	std::sort (candidates.begin(), candidates.end());
+	candidates.erase 
 	(
-		[&device, &widgets] (Linkable* obj)
+		std::unique 
+		(
+			candidates.begin(), 
+			candidates.end(), 
+			[] (const std::pair<size_t, bool>& a, const std::pair<size_t, bool>& b) {return a.first == b.first;}
+		), 
+		candidates.end()
+	);
+
+	// Sort puts hit (true) after not hit (false) entries. Restore hits.
+	for (std::pair<size_t, bool>& c : candidates) c.second = hitEntries_[c.first].area.contains (position) && (hitEntries_[c.first].area != BUtilities::Area<> ());
+
+	// Evaluate the filters in the same way as Widget::getWidgetAt() does
+	// by traversing the tree of candidates
+	std::vector<std::pair<size_t, Widget*>> stack;
+	stack.reserve (candidates.size());
+	for (size_t f = 0; f < filters.size(); ++f)
+	{
+		const std::function<bool (Widget* widget)>& func = filters[f].first;
+		const std::function<bool (Widget* widget)>& passfunc = filters[f].second;
+		Widget* result = nullptr;
+
+		auto pop = [this, &stack, &result] ()
 		{
-			Widget* w = dynamic_cast<Widget*>(obj);
-			if (w)
+			const size_t child = stack.back().first;
+			Widget* nextw = stack.back().second;
+			stack.pop_back();
+			if (stack.empty()) result = nextw;
+			else if (nextw)
 			{
-				if (w->isDeviceGrabbed(device)) widgets.push_back(w);
+				Widget*& finalw = stack.back().second;
+				if (finalw)
+				{
+					if (hitEntries_[child].layer <= hitEntries_[stack.back().first].layer) finalw = nextw;
+				}
+				else finalw = nextw;
 			}
-			return true;
+		};
+
+		for (const std::pair<size_t, bool>& c : candidates)
+		{
+			while ((!stack.empty()) && (c.first >= hitEntries_[stack.back().first].end)) pop();
+			Widget* w = hitEntries_[c.first].widget;
+			stack.push_back 
+			(
+				std::make_pair 
+				(
+					c.first, 
+					(c.second ? (passfunc (w) ? nullptr : (func (w) ? w : this)) : nullptr)
+				)
+			);
 		}
-	);
 
-	return widgets;
+		while (!stack.empty()) pop();
+		results[f] = result;
+	}
+
+	return results;
+}
+
+void Window::invalidateHitIndex ()
+{
+	hitIndexValid_ = false;
+	hitIndexUpdates_.clear();
+}
+
+void Window::updateHitIndex (const Widget* widget)
+{
+	if (!hitIndexValid_) return;
+	if (widget == this) 
+	{
+		invalidateHitIndex();
+		return;
+	}
+
+	std::unordered_map<const Widget*, size_t>::const_iterator it = hitEntryIndex_.find (widget);
+	if (it != hitEntryIndex_.cend()) hitIndexUpdates_.push_back (it->second);
+}
+
+void Window::validateHitIndex ()
+{
+	// Full rebuild
+	if (!hitIndexValid_)
+	{
+		hitEntries_.clear();
+		hitEntryIndex_.clear();
+		hitOpaqueEntries_.clear();
+		for (std::vector<size_t>& c : hitGrid_) c.clear();
+
+		hitGridArea_ = getAbsoluteArea();
+		hitGridColumns_ = std::ceil (hitGridArea_.getWidth() / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE) + 1;
+		hitGridRows_ = std::ceil (hitGridArea_.getHeight() / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE) + 1;
+		hitGrid_.resize (hitGridColumns_ * hitGridRows_);
+
+		buildHitIndex (this, SIZE_MAX, hitGridArea_);
+		for (size_t i = 0; i < hitEntries_.size(); ++i) insertHitEntry (i);
+
+		hitIndexUpdates_.clear();
+		hitIndexValid_ = true;
+		return;
+	}
+
+	// Update geometry of changed subtrees
+	for (size_t u : hitIndexUpdates_)
+	{
+		for (size_t i = u; i < hitEntries_[u].end; ++i) removeHitEntry (i);
+		for (size_t i = u; i < hitEntries_[u].end; ++i)
+		{
+			HitEntry& e = hitEntries_[i];
+			const HitEntry& p = hitEntries_[e.parent];
+			e.position = p.position + e.widget->getPosition();
+			e.area = BUtilities::Area<> (e.position, e.position + e.widget->getExtends());
+			e.area.intersect (e.widget->getStacking() == StackingType::escape ? hitGridArea_ : p.area);
+		}
+		for (size_t i = u; i < hitEntries_[u].end; ++i) insertHitEntry (i);
+	}
+	hitIndexUpdates_.clear();
+}
+
+void Window::buildHitIndex (Widget* widget, const size_t parent, const BUtilities::Area<>& outerArea)
+{
+	if (!widget->isVisualizable()) return;
+
+	const size_t index = hitEntries_.size();
+	HitEntry e;
+	e.widget = widget;
+	e.parent = parent;
+	e.end = index + 1;
+	e.layer = widget->Visualizable::getLayer();
+	e.position = widget->getPosition();
+	e.area = outerArea;
+	if (parent != SIZE_MAX)
+	{
+		const HitEntry& p = hitEntries_[parent];
+		if (e.layer == BWIDGETS_UNDEFINED_LAYER) e.layer = p.layer;
+		e.position = p.position + widget->getPosition();
+		if (widget->getStacking() != StackingType::escape) e.area = p.area;
+	}
+	else e.position = widget->getAbsolutePosition();
+
+	BUtilities::Area<> thisArea = BUtilities::Area<> (e.position, e.position + widget->getExtends());
+	thisArea.intersect (e.area);
+	e.area = thisArea;
+	hitEntries_.push_back (e);
+	hitEntryIndex_[widget] = index;
+	if (widget->isOpaque()) hitOpaqueEntries_.push_back (index);
+
+	for (Linkable* l : widget->getChildren())
+	{
+		Widget* w = dynamic_cast<Widget*> (l);
+		if (w) buildHitIndex (w, index, outerArea);
+	}
+
+	hitEntries_[index].end = hitEntries_.size();
+}
+
+bool Window::isOccluded (const Widget* widget, const BUtilities::Area<>& area, const bool family)
+{
+	validateHitIndex ();
+	if (hitOpaqueEntries_.empty()) return false;
+
+	std::unordered_map<const Widget*, size_t>::const_iterator it = hitEntryIndex_.find (widget);
+	if (it == hitEntryIndex_.cend()) return false;
+	const size_t index = it->second;
+	const int layer = hitEntries_[index].layer;
+	const size_t end = (family ? hitEntries_[index].end : index + 1);
+
+	// Subtract the areas of all opaque widgets in front of widget (lower
+	// layer or same layer and later in tree order) from area. Optionally
+	// without the children of widget.
+	occlusionRest_.clear();
+	occlusionRest_.push_back (area);
+	for (size_t o : hitOpaqueEntries_)
+	{
+		const HitEntry& e = hitEntries_[o];
+		if (((o >= index) && (o < end)) || (e.layer > layer) || ((e.layer == layer) && (o < index))) continue;
+
+		const double ox1 = e.area.getX();
+		const double ox2 = e.area.getX() + e.area.getWidth();
+		const double oy1 = e.area.getY();
+		const double oy2 = e.area.getY() + e.area.getHeight();
+		occlusionNext_.clear();
+		for (const BUtilities::Area<>& r : occlusionRest_)
+		{
+			const double x1 = r.getX();
+			const double x2 = r.getX() + r.getWidth();
+			const double y1 = r.getY();
+			const double y2 = r.getY() + r.getHeight();
+
+			// No overlap: keep
+			if ((ox1 >= x2) || (ox2 <= x1) || (oy1 >= y2) || (oy2 <= y1))
+			{
+				occlusionNext_.push_back (r);
+				continue;
+			}
+
+			// Overlap: keep the up to four uncovered parts
+			const double my1 = std::max (y1, oy1);
+			const double my2 = std::min (y2, oy2);
+			if (oy1 > y1) occlusionNext_.push_back (BUtilities::Area<> (x1, y1, x2 - x1, oy1 - y1));
+			if (oy2 < y2) occlusionNext_.push_back (BUtilities::Area<> (x1, oy2, x2 - x1, y2 - oy2));
+			if (ox1 > x1) occlusionNext_.push_back (BUtilities::Area<> (x1, my1, ox1 - x1, my2 - my1));
+			if (ox2 < x2) occlusionNext_.push_back (BUtilities::Area<> (ox2, my1, x2 - ox2, my2 - my1));
+		}
+		occlusionRest_.swap (occlusionNext_);
+
+		if (occlusionRest_.empty()) return true;
+	}
+
+	return false;
+}
+
+void Window::validateStyles ()
+{
+	if (stylesValid_) return;
+	stylesValid_ = true;
+
+	// Single top-down pass. Widgets with the same style source share a 
+	// resolved style record. Expose requests are collected into a single one.
+	stylesValidating_ = true;
+	validateStyles (this, false);
+	stylesValidating_ = false;
+	styleExposeCovered_ = false;
+	styleRecords_.clear();
+
+	if (styleExposeArea_ != BUtilities::Area<> ())
+	{
+		exposeRegion_.add (styleExposeArea_);
+		styleExposeArea_ = BUtilities::Area<> ();
+	}
+}
+
+bool Window::validateStyles (Widget* widget, const bool covered)
+{
+	widget->validateStyle (&styleRecords_);
+	const bool changed = widget->styleChanged_;
+
+	bool childChanged = false;
+	for (Linkable* l : widget->children_)
+	{
+		Widget* w = dynamic_cast<Widget*> (l);
+		if (w && validateStyles (w, covered || changed)) childChanged = true;
+	}
+	widget->styleSources_.clear ();
+
+	// Update after the children (as in setStyle() ). Also update if the 
+	// style of a child changed as composite widgets may take their layout
+	// from their children. The family area of a changed parent widget also 
+	// covers the expose area of this widget.
+	if (changed || childChanged)
+	{
+		widget->styleChanged_ = false;
+		styleExposeCovered_ = covered;
+		widget->update ();
+	}
+
+	return changed;
+}
+
+void Window::insertHitEntry (const size_t index)
+{
+	const BUtilities::Area<>& a = hitEntries_[index].area;
+	if (a == BUtilities::Area<> ()) return;
+
+	const double x0 = hitGridArea_.getX();
+	const double y0 = hitGridArea_.getY();
+	const size_t c1 = std::min (static_cast<size_t> (std::max ((a.getX() - x0) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE, 0.0)), hitGridColumns_ - 1);
+	const size_t c2 = std::min (static_cast<size_t> (std::max ((a.getX() + a.getWidth() - x0) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE, 0.0)), hitGridColumns_ - 1);
+	const size_t r1 = std::min (static_cast<size_t> (std::max ((a.getY() - y0) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE, 0.0)), hitGridRows_ - 1);
+	const size_t r2 = std::min (static_cast<size_t> (std::max ((a.getY() + a.getHeight() - y0) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE, 0.0)), hitGridRows_ - 1);
+
+	for (size_t r = r1; r <= r2; ++r)
+	{
+		for (size_t c = c1; c <= c2; ++c)
+		{
+			// Keep tree order
+			std::vector<size_t>& cell = hitGrid_[r * hitGridColumns_ + c];
+			cell.insert (std::upper_bound (cell.begin(), cell.end(), index), index);
+		}
+	}
+}
+
+void Window::removeHitEntry (const size_t index)
+{
+	const BUtilities::Area<>& a = hitEntries_[index].area;
+	if (a == BUtilities::Area<> ()) return;
+
+	const double x0 = hitGridArea_.getX();
+	const double y0 = hitGridArea_.getY();
+	const size_t c1 = std::min (static_cast<size_t> (std::max ((a.getX() - x0) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE, 0.0)), hitGridColumns_ - 1);
+	const size_t c2 = std::min (static_cast<size_t> (std::max ((a.getX() + a.getWidth() - x0) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE, 0.0)), hitGridColumns_ - 1);
+	const size_t r1 = std::min (static_cast<size_t> (std::max ((a.getY() - y0) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE, 0.0)), hitGridRows_ - 1);
+	const size_t r2 = std::min (static_cast<size_t> (std::max ((a.getY() + a.getHeight() - y0) / BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE, 0.0)), hitGridRows_ - 1);
+
+	for (size_t r = r1; r <= r2; ++r)
+	{
+		for (size_t c = c1; c <= c2; ++c)
+		{
+			std::vector<size_t>& cell = hitGrid_[r * hitGridColumns_ + c];
+			std::vector<size_t>::iterator it = std::lower_bound (cell.begin(), cell.end(), index);
+			if ((it != cell.end()) && (*it == index)) cell.erase (it);
+		}
+	}
 }
 
 void Window::setZoom (const double zoom)
 {
-	if (zoom != zoom_)
+	if ((zoom > 0.0) && (zoom != zoom_))
 	{
 		zoom_ = zoom;
+
+		// Render all linked widgets at the new device scale
+		setScale (zoom);
+		forEachChild
+		(
+			[zoom] (Linkable* l)
+			{
+				Widget* w = dynamic_cast<Widget*> (l);
+				if (w) w->setScale (zoom);
+				return true;
+			}
+		);
+		destroyLayerSurfaces ();
+		if (isOffscreen()) createOffscreenSurface ();
 		update();
 	}
 }
 
+void Window::setDrawThreads (const size_t threads)
+{
+	if (threads == getDrawThreads()) return;
+	drawPool_.reset (threads ? new BUtilities::ThreadPool (threads) : nullptr);
+}
+
+size_t Window::getDrawThreads () const
+{
+	return (drawPool_ ? drawPool_->size() : 0);
+}
+
+void Window::setSurfaceBudget (const size_t bytes)
+{
+	surfaceList_.budget = bytes;
+	enforceSurfaceBudget (surfaceList_);
+}
+
+size_t Window::getSurfaceBudget () const
+{
+	return surfaceList_.budget;
+}
+
+size_t Window::getTotalSurfaceBytes () const
+{
+	return surfaceList_.bytes;
+}
+
+bool Window::isResizing () const
+{
+	return resizing_;
+}
+
 double Window::getZoom () const
 {
 	return zoom_;
@@ -190,12 +648,201 @@ PuglView* Window::getView () {return view_;}
 
 cairo_t* Window::getCairoContext ()
 {
+	if (offscreenContext_) return offscreenContext_;
 	return (view_ ? static_cast<cairo_t*>(puglGetContext(view_)): nullptr);
 }
 
+bool Window::isOffscreen () const
+{
+	return (offscreenSurface_ != nullptr);
+}
+
+cairo_surface_t* Window::getOffscreenSurface ()
+{
+	return offscreenSurface_;
+}
+
+bool Window::writeToPng (const std::string& filename)
+{
+	if (!offscreenSurface_) return false;
+	cairo_surface_flush (offscreenSurface_);
+	return (cairo_surface_write_to_png (offscreenSurface_, filename.c_str()) == CAIRO_STATUS_SUCCESS);
+}
+
+void Window::sendEvent (const PuglEvent& event)
+{
+	translateEvent (&event);
+}
+
+void Window::sendButtonEvent (const BUtilities::Point<>& position, const uint32_t button, const bool press)
+{
+	PuglEvent event {};
+	event.button.type = (press ? PUGL_BUTTON_PRESS : PUGL_BUTTON_RELEASE);
+	event.button.x = position.x * getZoom();
+	event.button.y = position.y * getZoom();
+	event.button.xRoot = event.button.x;
+	event.button.yRoot = event.button.y;
+	event.button.button = button;
+	translateEvent (&event);
+}
+
+void Window::sendMotionEvent (const BUtilities::Point<>& position)
+{
+	PuglEvent event {};
+	event.motion.type = PUGL_MOTION;
+	event.motion.x = position.x * getZoom();
+	event.motion.y = position.y * getZoom();
+	event.motion.xRoot = event.motion.x;
+	event.motion.yRoot = event.motion.y;
+	translateEvent (&event);
+}
+
+void Window::sendScrollEvent (const BUtilities::Point<>& position, const BUtilities::Point<>& delta)
+{
+	PuglEvent event {};
+	event.scroll.type = PUGL_SCROLL;
+	event.scroll.x = position.x * getZoom();
+	event.scroll.y = position.y * getZoom();
+	event.scroll.xRoot = event.scroll.x;
+	event.scroll.yRoot = event.scroll.y;
+	event.scroll.dx = delta.x * getZoom();
+	event.scroll.dy = delta.y * getZoom();
+	translateEvent (&event);
+}
+
+void Window::sendKeyEvent (const uint32_t key, const bool press)
+{
+	PuglEvent event {};
+	event.key.type = (press ? PUGL_KEY_PRESS : PUGL_KEY_RELEASE);
+	event.key.x = pointer_.x * getZoom();
+	event.key.y = pointer_.y * getZoom();
+	event.key.key = key;
+	translateEvent (&event);
+
+	// Pugl sends characters additionally as text events
+	if (press && ((key < PUGL_KEY_F1) || (key > PUGL_KEY_PAUSE)))
+	{
+		PuglEvent text {};
+		text.text.type = PUGL_TEXT;
+		text.text.x = event.key.x;
+		text.text.y = event.key.y;
+		text.text.character = key;
+		translateEvent (&text);
+	}
+}
+
+void Window::sendConfigureEvent (const BUtilities::Point<>& extends)
+{
+	PuglEvent event {};
+	event.configure.type = PUGL_CONFIGURE;
+	event.configure.width = static_cast<PuglSpan> (std::ceil (extends.x * getZoom()));
+	event.configure.height = static_cast<PuglSpan> (std::ceil (extends.y * getZoom()));
+	translateEvent (&event);
+}
+
+void Window::setFrameRate (const double fps)
+{
+	frameRate_ = std::max (fps, 0.0);
+}
+
+double Window::getFrameRate () const
+{
+	return frameRate_;
+}
+
+void Window::scheduleWakeup (const std::chrono::steady_clock::time_point& time)
+{
+	if (time < wakeup_) wakeup_ = time;
+}
+
+double Window::getWakeupTimeout () const
+{
+	if ((!eventQueue_.empty()) || (!inboxPending_.empty()) || (!inbox_.empty())) return 0.0;
+
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point next = wakeup_;
+
+	// Poll the inbox once per frame if other threads inject values
+	if (inboxUsed_.load (std::memory_order_relaxed))
+	{
+		const double fps = (frameRate_ > 0.0 ? frameRate_ : BWIDGETS_DEFAULT_FRAME_RATE);
+		next = std::min (next, now + std::chrono::duration_cast<std::chrono::steady_clock::duration> (std::chrono::duration<double> (1.0 / fps)));
+	}
+
+	// Pending redisplay
+	if (!exposeRegion_.empty()) next = std::min (next, nextFrame_);
+
+	// Pointer focus in / out
+	std::list<Widget*> gwidgets = listDeviceGrabbed (BDevices::MouseButton (BDevices::MouseButton::ButtonType::none));
+	for (Widget* widget : gwidgets)
+	{
+		const PointerFocusable* focus = dynamic_cast<const PointerFocusable*> (widget);
+		const BDevices::Device* dev = widget->getDevice (BDevices::MouseButton (BDevices::MouseButton::ButtonType::none));
+		if (focus && dev)
+		{
+			const std::chrono::steady_clock::time_point focusOutTime = dev->getActionTime() + focus->getFocusOutMilliseconds();
+			if (focused_) next = std::min (next, focusOutTime);
+			else if (now < focusOutTime) next = std::min (next, dev->getActionTime() + focus->getFocusInMilliseconds());
+		}
+	}
+
+	if (next == std::chrono::steady_clock::time_point::max()) return -1.0;
+	if (next <= now) return 0.0;
+	return std::chrono::duration<double> (next - now).count();
+}
+
+Window::LoopStatistics Window::getLoopStatistics () const
+{
+	const double seconds = std::chrono::duration<double> (std::chrono::steady_clock::now() - loopStart_).count();
+	return LoopStatistics 
+	{
+		loopWakeups_,
+		loopFrames_,
+		(seconds > 0.0 ? loopWakeups_ / seconds : 0.0),
+		(seconds > 0.0 ? loopFrames_ / seconds : 0.0),
+		loopBlocked_,
+		loopBusy_
+	};
+}
+
+void Window::resetLoopStatistics ()
+{
+	loopWakeups_ = 0;
+	loopFrames_ = 0;
+	loopStart_ = std::chrono::steady_clock::now();
+	loopBlocked_ = std::chrono::duration<double> (0.0);
+	loopBusy_ = std::chrono::duration<double> (0.0);
+}
+
 void Window::run ()
 {
-	while (!quit_) handleEvents();
+	while (!quit_) 
+	{
+		waitEvents ();
+		handleEvents ();
+	}
+}
+
+void Window::waitEvents ()
+{
+	const double timeout = getWakeupTimeout ();
+	if (timeout == 0.0) return;
+
+	// Blocked time = time in puglUpdate without the time for event 
+	// translation (see translatePuglEvent)
+	const std::chrono::duration<double> busy0 = loopBusy_;
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	if (world_) puglUpdate (world_, timeout);
+
+	// Offscreen: No host system events to wait for. Sleep until the timeout
+	// or, if nothing is scheduled, until the next frame to poll the inbox.
+	else
+	{
+		const double fps = (frameRate_ > 0.0 ? frameRate_ : BWIDGETS_DEFAULT_FRAME_RATE);
+		std::this_thread::sleep_for (std::chrono::duration<double> (timeout > 0.0 ? timeout : 1.0 / fps));
+	}
+
+	loopBlocked_ += (std::chrono::steady_clock::now() - t0) - (loopBusy_ - busy0);
 }
 
 void Window::onConfigureRequest (BEvents::Event* event)
@@ -203,7 +850,21 @@ void Window::onConfigureRequest (BEvents::Event* event)
 
 	Widget::onConfigureRequest (event);
 	BEvents::ExposeEvent* ev = dynamic_cast<BEvents::ExposeEvent*>(event);
-	if (ev && (getExtends () != ev->getArea().getExtends () / getZoom())) Widget::resize (ev->getArea().getExtends () / getZoom());
+	if (ev && (getExtends () != ev->getArea().getExtends () / getZoom())) 
+	{
+		// Defer redraws until the resize settles
+		if (!isOffscreen())
+		{
+			resizing_ = true;
+			resizeTime_ = std::chrono::steady_clock::now();
+			scheduleWakeup (resizeTime_ + std::chrono::milliseconds (BWIDGETS_DEFAULT_RESIZE_SETTLE_TIME));
+		}
+
+		Widget::resize (ev->getArea().getExtends () / getZoom());
+		destroyLayerSurfaces ();
+		redisplayRegion_.clear();		// Host system exposes the whole window
+		if (isOffscreen()) createOffscreenSurface ();
+	}
 }
 
 void Window::onCloseRequest (BEvents::Event* event)
@@ -216,10 +877,13 @@ void Window::onCloseRequest (BEvents::Event* event)
 void Window::onExposeRequest (BEvents::Event* event)
 {
 	BEvents::ExposeEvent* ev = dynamic_cast<BEvents::ExposeEvent*>(event);
-	if (ev) puglPostRedisplayRect (view_,	{static_cast<PuglCoord>(ev->getArea().getX() * getZoom()), 
-											 static_cast<PuglCoord>(ev->getArea().getY() * getZoom()), 
-											 static_cast<PuglSpan>((ev->getArea().getWidth()) * getZoom()), 
-											 static_cast<PuglSpan>((ev->getArea().getHeight()) * getZoom())});
+	if (ev)
+	{
+		// Collect and post once per frame (offscreen: at the end of
+		// handleEvents() )
+		exposeRegion_.add (ev->getRegion());
+		if (!isOffscreen()) postRedisplay ();
+	}
 }
 
 void Window::addEventToQueue (BEvents::Event* event)
@@ -229,8 +893,7 @@ void Window::addEventToQueue (BEvents::Event* event)
 	(
 		(event) &&
 		(event->getWidget()) &&
-		(!eventQueue_.empty ()) &&
-		(eventQueue_.back())
+		(!eventQueue_.empty ())
 	)
 	{
 		BEvents::Event::EventType eventType = event->getEventType();
@@ -248,102 +911,96 @@ void Window::addEventToQueue (BEvents::Event* event)
 			)
 		)
 		{
-			// Check for mergeable precursor events
-			for (std::list<BEvents::Event*>::reverse_iterator rit = eventQueue_.rbegin(); rit != eventQueue_.rend(); ++rit)
+			// Lookup for the latest mergeable precursor event
+			BEvents::Event* precursor = getQueuedEvent (event->getWidget (), eventType);
+
+			// Don't merge the same event pointer
+			if (precursor && (precursor != event))
 			{
-				BEvents::Event* precursor = *rit;
+				// CONFIGURE_EVENT
+				if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::configureRequestEvent))
+				{
+					BEvents::ExposeEvent* firstEvent = (BEvents::ExposeEvent*) precursor;
+					BEvents::ExposeEvent* nextEvent = (BEvents::ExposeEvent*) event;
 
-				// Don't add the same event pointer twice
-				if (precursor == event)
+					BUtilities::Area<> area = nextEvent->getArea ();
+					firstEvent->setArea (area);
+
+					BEvents::EventPool::dispose (event);
+					return;
+				}
 
-				if ((static_cast<uint32_t>(precursor->getEventType()) & static_cast<uint32_t>(eventType)) && (event->getWidget () == precursor->getWidget ()))
+				// EXPOSE_EVENT
+				else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::exposeRequestEvent))
 				{
-					// CONFIGURE_EVENT
-					if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::configureRequestEvent))
-					{
-						BEvents::ExposeEvent* firstEvent = (BEvents::ExposeEvent*) precursor;
-						BEvents::ExposeEvent* nextEvent = (BEvents::ExposeEvent*) event;
+					BEvents::ExposeEvent* firstEvent = (BEvents::ExposeEvent*) precursor;
+					BEvents::ExposeEvent* nextEvent = (BEvents::ExposeEvent*) event;
 
-						BUtilities::Area<> area = nextEvent->getArea ();
-						firstEvent->setArea (area);
+					BUtilities::Region<> region = firstEvent->getRegion ();
+					region.add (nextEvent->getRegion ());
+					firstEvent->setRegion (region);
 
-						delete event;
-						return;
-					}
+					BEvents::EventPool::dispose (event);
+					return;
+				}
 
-					// EXPOSE_EVENT
-					if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::exposeRequestEvent))
-					{
-						BEvents::ExposeEvent* firstEvent = (BEvents::ExposeEvent*) precursor;
-						BEvents::ExposeEvent* nextEvent = (BEvents::ExposeEvent*) event;
 
-						BUtilities::Area<> area = firstEvent->getArea ();
-						area.extend (nextEvent->getArea ());
-						firstEvent->setArea (area);
+				// pointerMotionEvent
+				else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::pointerMotionEvent))
+				{
+					BEvents::PointerEvent* firstEvent = (BEvents::PointerEvent*) precursor;
+					BEvents::PointerEvent* nextEvent = (BEvents::PointerEvent*) event;
 
-						delete event;
-						return;
-					}
+					firstEvent->setPosition (nextEvent->getPosition ());
+					firstEvent->setDelta (firstEvent->getDelta () + nextEvent->getDelta ());
 
+					BEvents::EventPool::dispose (event);
+					return;
+				}
 
-					// pointerMotionEvent
-					else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::pointerMotionEvent))
-					{
-						BEvents::PointerEvent* firstEvent = (BEvents::PointerEvent*) precursor;
-						BEvents::PointerEvent* nextEvent = (BEvents::PointerEvent*) event;
+				// pointerDragEvent
+				else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::pointerDragEvent))
+				{
+					BEvents::PointerEvent* firstEvent = (BEvents::PointerEvent*) precursor;
+					BEvents::PointerEvent* nextEvent = (BEvents::PointerEvent*) event;
 
+					if
+					(
+						(nextEvent->getButton() == firstEvent->getButton()) &&
+						(nextEvent->getOrigin() == firstEvent->getOrigin())
+					)
+					{
 						firstEvent->setPosition (nextEvent->getPosition ());
 						firstEvent->setDelta (firstEvent->getDelta () + nextEvent->getDelta ());
 
-						delete event;
+						BEvents::EventPool::dispose (event);
 						return;
 					}
+				}
 
-					// pointerDragEvent
-					else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::pointerDragEvent))
-					{
-						BEvents::PointerEvent* firstEvent = (BEvents::PointerEvent*) precursor;
-						BEvents::PointerEvent* nextEvent = (BEvents::PointerEvent*) event;
-
-						if
-						(
-							(nextEvent->getButton() == firstEvent->getButton()) &&
-							(nextEvent->getOrigin() == firstEvent->getOrigin())
-						)
-						{
-							firstEvent->setPosition (nextEvent->getPosition ());
-							firstEvent->setDelta (firstEvent->getDelta () + nextEvent->getDelta ());
-
-							delete event;
-							return;
-						}
-					}
 
+				// wheelScrollEvent
+				else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::wheelScrollEvent))
+				{
+					BEvents::WheelEvent* firstEvent = (BEvents::WheelEvent*) precursor;
+					BEvents::WheelEvent* nextEvent = (BEvents::WheelEvent*) event;
 
-					// wheelScrollEvent
-					else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::wheelScrollEvent))
+					if (nextEvent->getPosition() == firstEvent->getPosition())
 					{
-						BEvents::WheelEvent* firstEvent = (BEvents::WheelEvent*) precursor;
-						BEvents::WheelEvent* nextEvent = (BEvents::WheelEvent*) event;
-
-						if (nextEvent->getPosition() == firstEvent->getPosition())
-						{
-							firstEvent->setDelta (firstEvent->getDelta () + nextEvent->getDelta ());
+						firstEvent->setDelta (firstEvent->getDelta () + nextEvent->getDelta ());
 
-							delete event;
-							return;
-						}
+						BEvents::EventPool::dispose (event);
+						return;
 					}
+				}
 
-					// ValueChangedEvent
-					else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::valueChangedEvent))
+				// ValueChangedEvent
+				else if (static_cast<uint32_t>(eventType) & static_cast<uint32_t>(BEvents::Event::EventType::valueChangedEvent))
+				{
+					if (dynamic_cast<BEvents::ValueChangedEvent*>(precursor))
 					{
-						if (dynamic_cast<BEvents::ValueChangedEvent*>(precursor))
-						{
-							dynamic_cast<BEvents::ValueChangedEvent*>(precursor)->setValue (event);
-							delete event;
-						}
-						
+						dynamic_cast<BEvents::ValueChangedEvent*>(precursor)->setValue (event);
+						BEvents::EventPool::dispose (event);
 						return;
 					}
 				}
@@ -356,8 +1013,32 @@ void Window::addEventToQueue (BEvents::Event* event)
 
 void Window::handleEvents ()
 {
-	puglUpdate (world_, 0);
+	// Busy time = total time of this method. Nested measurements (see 
+	// translatePuglEvent) are overwritten at the end.
+	const std::chrono::duration<double> busy0 = loopBusy_;
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	++loopWakeups_;
+
+	// Resolve styles changed outside the event loop before the host system 
+	// exposes
+	validateStyles ();
+	if (world_) puglUpdate (world_, 0);
 	translateTimeEvent ();
+	if (t0 >= wakeup_) wakeup_ = std::chrono::steady_clock::time_point::max();
+
+	// Resize settled: redraw previews
+	if (resizing_)
+	{
+		const std::chrono::steady_clock::time_point settleTime = resizeTime_ + std::chrono::milliseconds (BWIDGETS_DEFAULT_RESIZE_SETTLE_TIME);
+		if (t0 >= settleTime)
+		{
+			resizing_ = false;
+			emitExposeEvent ();
+		}
+		else scheduleWakeup (settleTime);
+	}
+	drainInbox ();
+	processInbox ();
 
 	while (!eventQueue_.empty ())
 	{
@@ -481,12 +1162,26 @@ void Window::handleEvents ()
 			deleteEvent (event);
 		}
 	}
+
+	// Resolve pushed styles and post collected expose requests if the next 
+	// frame is due
+	validateStyles ();
+	postRedisplay ();
+
+	loopBusy_ = busy0 + (std::chrono::steady_clock::now() - t0);
 }
 
 PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEvent)
 {
 	Window* w = (Window*) puglGetHandle (view);
 	if (!w) return PUGL_BAD_PARAMETER;
+	return w->translateEvent (puglEvent);
+}
+
+PuglStatus Window::translateEvent (const PuglEvent* puglEvent)
+{
+	Window* w = this;
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
 
 	switch (puglEvent->type) {
 
@@ -511,7 +1206,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 				{
 					if (gw && gw->is<KeyPressable>())
 					{
-						w->addEventToQueue(new BEvents::KeyEvent (gw, BEvents::Event::EventType::keyPressEvent, puglEvent->key.x, puglEvent->key.y, key));
+						w->addEventToQueue(w->createEvent<BEvents::KeyEvent> (gw, BEvents::Event::EventType::keyPressEvent, puglEvent->key.x, puglEvent->key.y, key));
 					}
 				}
 			}
@@ -539,7 +1234,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 				{
 					if (gw && gw->is<KeyPressable>())
 					{
-						w->addEventToQueue(new BEvents::KeyEvent (gw, BEvents::Event::EventType::keyReleaseEvent, puglEvent->key.x, puglEvent->key.y, key));
+						w->addEventToQueue(w->createEvent<BEvents::KeyEvent> (gw, BEvents::Event::EventType::keyReleaseEvent, puglEvent->key.x, puglEvent->key.y, key));
 					}
 				}
 			}
@@ -565,7 +1260,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 				{
 					if (gw && gw->is<KeyPressable>())
 					{
-						w->addEventToQueue(new BEvents::KeyEvent (gw, BEvents::Event::EventType::keyPressEvent, puglEvent->key.x, puglEvent->key.y, key));
+						w->addEventToQueue(w->createEvent<BEvents::KeyEvent> (gw, BEvents::Event::EventType::keyPressEvent, puglEvent->key.x, puglEvent->key.y, key));
 					}
 				}
 			}
@@ -581,7 +1276,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 			{
 				w->addEventToQueue
 				(
-					new BEvents::PointerEvent
+					w->createEvent<BEvents::PointerEvent>
 					(
 						widget,
 						BEvents::Event::EventType::buttonPressEvent,
@@ -610,7 +1305,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 
 				w->addEventToQueue
 				(
-					new BEvents::PointerEvent
+					w->createEvent<BEvents::PointerEvent>
 					(
 						widget,
 						BEvents::Event::EventType::buttonReleaseEvent,
@@ -629,7 +1324,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 				{
 					w->addEventToQueue
 					(
-						new BEvents::PointerEvent
+						w->createEvent<BEvents::PointerEvent>
 						(
 							widget,
 							BEvents::Event::EventType::buttonClickEvent,
@@ -666,7 +1361,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 
 					w->addEventToQueue
 					(
-						new BEvents::PointerEvent
+						w->createEvent<BEvents::PointerEvent>
 						(
 							widget,
 							BEvents::Event::EventType::pointerDragEvent,
@@ -682,40 +1377,41 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 			// No button associated with a widget? Only pointerMotionEvent or FOCUS_EVENT
 			if (button == BDevices::MouseButton::ButtonType::none)
 			{
-				// pointerMotionEvent
-				Widget* widget = w->getWidgetAt	(position, 
-												 [] (Widget* widget) {return widget->is<Pointable>();},
-												 [] (Widget* widget) {return widget->isEventPassable (BEvents::Event::EventType::pointerMotionEvent);});
-				if (widget && (widget != w))
-				{
-					w->addEventToQueue
-					(
-						new BEvents::PointerEvent
+				// pointerMotionEvent and FOCUS_EVENT: Single lookup for both
+				std::vector<Widget*> widgets = w->getWidgetsAt	
+				(
+					position, 
+					{
+						WidgetFilter 
 						(
-							widget,
-							BEvents::Event::EventType::pointerMotionEvent,
-							position - widget->getAbsolutePosition (),
-							BUtilities::Point<> (),
-							position - w->pointer_,
-							button));
-				}
+							[] (Widget* widget) {return widget->is<Pointable>();},
+							[] (Widget* widget) {return widget->isEventPassable (BEvents::Event::EventType::pointerMotionEvent);}
+						),
+						WidgetFilter
+						(
+							[] (Widget* widget) {return widget->is<PointerFocusable>();},
+							[] (Widget* widget) {return widget->isEventPassable (BEvents::Event::EventType::pointerFocusInEvent);}
+						)
+					}
+				);
 
-				// FOCUS_EVENT
-				widget = w->getWidgetAt	(position, 
-												 [] (Widget* widget) {return widget->is<PointerFocusable>();},
-												 [] (Widget* widget) {return widget->isEventPassable (BEvents::Event::EventType::pointerFocusInEvent);});
-				if (widget && (widget != w))
+				for (Widget* widget : widgets)
 				{
-					w->addEventToQueue
-					(
-						new BEvents::PointerEvent
+					if (widget && (widget != w))
+					{
+						w->addEventToQueue
 						(
-							widget,
-							BEvents::Event::EventType::pointerMotionEvent,
-							position - widget->getAbsolutePosition (),
-							BUtilities::Point<> (),
-							position - w->pointer_,
-							button));
+							w->createEvent<BEvents::PointerEvent>
+							(
+								widget,
+								BEvents::Event::EventType::pointerMotionEvent,
+								position - widget->getAbsolutePosition (),
+								BUtilities::Point<> (),
+								position - w->pointer_,
+								button
+							)
+						);
+					}
 				}
 
 
@@ -735,7 +1431,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 			{
 				w->addEventToQueue
 				(
-					new BEvents::WheelEvent
+					w->createEvent<BEvents::WheelEvent>
 					(
 						widget,
 						BEvents::Event::EventType::wheelScrollEvent,
@@ -753,7 +1449,7 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 		{
 			w->addEventToQueue
 			(
-				new BEvents::ExposeEvent
+				w->createEvent<BEvents::ExposeEvent>
 				(
 					w, w,
 					BEvents::Event::EventType::configureRequestEvent,
@@ -769,68 +1465,234 @@ PuglStatus Window::translatePuglEvent (PuglView* view, const PuglEvent* puglEven
 	// Expose events handled HERE
 	case PUGL_EXPOSE:
 		{
-			// Calculate the non-zoomed area from the event data
-			BUtilities::Area<> area = BUtilities::Area<>	(puglEvent->expose.x / w->getZoom(), 
-															 puglEvent->expose.y / w->getZoom(), 
-															 puglEvent->expose.width / w->getZoom(), 
-															 puglEvent->expose.height / w->getZoom());
+			++w->loopFrames_;
+
+			// Redisplays posted by this window (see postRedisplay) may be
+			// merged by the host system to their bounding box. Then only 
+			// expose the posted areas. Otherwise (e.g., a host system 
+			// initiated expose) expose the whole area.
+			const BUtilities::Area<> exposeArea = BUtilities::Area<> (puglEvent->expose.x, puglEvent->expose.y, puglEvent->expose.width, puglEvent->expose.height);
+			// Drop posted areas outside the (maybe shrunk) window
+			BUtilities::Region<> region;
+			w->redisplayRegion_.intersect (BUtilities::Area<> (0, 0, std::ceil (w->getWidth() * w->getZoom()), std::ceil (w->getHeight() * w->getZoom())));
+			if (w->redisplayRegion_.getBoundingBox() == exposeArea) 
+			{
+				region = w->redisplayRegion_;
+				w->redisplayRegion_.clear();
+			}
+			else
+			{
+				region.add (exposeArea);
+				w->redisplayRegion_.remove (exposeArea);
+			}
 
 			// Get access to the host provided surface
 			cairo_t* crw = w->getCairoContext ();
-			if (crw && (cairo_status (crw) == CAIRO_STATUS_SUCCESS))
-			{
-				// Create a temporary window surface
-				cairo_surface_t* windowSurface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, w->getWidth() , w->getHeight());
-				if (windowSurface && (cairo_surface_status (windowSurface) == CAIRO_STATUS_SUCCESS))
-				{
-					//Get access to the temporary window surface
-					cairo_t* cr = cairo_create(windowSurface);
-					if (cr && (cairo_status (cr) == CAIRO_STATUS_SUCCESS))
-					{
-						// Get a map of layered surfaces for the selected area
-						std::map<int,cairo_surface_t*> storageSurfaces;
-						w->display (storageSurfaces, BUtilities::Point<> (w->getWidth(), w->getHeight()), area);
-
-						// Write all layered surfaces to the temporary window surface from back to front
-						for (std::map<int,cairo_surface_t*>::reverse_iterator rit = storageSurfaces.rbegin(); rit != storageSurfaces.rend(); ++rit)
-						{
-							cairo_surface_t* s = rit->second;
-							if (s && (cairo_surface_status (s) == CAIRO_STATUS_SUCCESS))
-							{
-								cairo_save (cr);
-								cairo_set_source_surface (cr, s, 0.0, 0.0);
-								cairo_paint (cr);
-								cairo_restore (cr);
-								cairo_surface_destroy(s);
-							}
-						}
-
-						cairo_destroy (cr);	
-					}
-
-					// Write temporary window surface to the host provided surface
-					cairo_save (crw);
-					cairo_scale (crw, w->getZoom(), w->getZoom());
-					cairo_set_source_surface (crw, windowSurface, 0.0, 0.0);
-					cairo_paint (crw);
-					cairo_restore (crw);
-					cairo_surface_destroy (windowSurface);
-				}
-			}
+			if (crw && (cairo_status (crw) == CAIRO_STATUS_SUCCESS)) w->exposeLayers (crw, region);
 		}
 		break;
 
 	case PUGL_CLOSE:
-		if (w->is<Closeable>()) w->addEventToQueue (new BEvents::WidgetEvent (w, w, BEvents::Event::EventType::closeRequestEvent));
+		if (w->is<Closeable>()) w->addEventToQueue (w->createEvent<BEvents::WidgetEvent> (w, w, BEvents::Event::EventType::closeRequestEvent));
 		break;
 
 	default:
 		break;
 	}
 
+	w->loopBusy_ += std::chrono::steady_clock::now() - t0;
 	return PUGL_SUCCESS;
 }
 
+void Window::exposeLayers (cairo_t* cr, const BUtilities::Region<>& region)
+{
+	// Layer surfaces are rendered at device resolution. Damaged areas in
+	// full device pixels (deviceRegion) and in logical units (layerRegion).
+	const int width = std::ceil (getWidth() * getZoom());
+	const int height = std::ceil (getHeight() * getZoom());
+	BUtilities::Region<> deviceRegion;
+	for (const BUtilities::Area<>& a : region)
+	{
+		const double x0 = std::max (std::floor (a.getX()), 0.0);
+		const double y0 = std::max (std::floor (a.getY()), 0.0);
+		const double x1 = std::min (std::ceil (a.getX() + a.getWidth()), static_cast<double> (width));
+		const double y1 = std::min (std::ceil (a.getY() + a.getHeight()), static_cast<double> (height));
+		if ((x1 > x0) && (y1 > y0)) deviceRegion.add (BUtilities::Area<> (x0, y0, x1 - x0, y1 - y0));
+	}
+	if (deviceRegion.empty()) return;
+
+	BUtilities::Region<> layerRegion;
+	for (const BUtilities::Area<>& a : deviceRegion)
+	{
+		layerRegion.add (BUtilities::Area<> (a.getX() / getZoom(), a.getY() / getZoom(), a.getWidth() / getZoom(), a.getHeight() / getZoom()));
+	}
+
+	auto addPath = [] (cairo_t* c, const BUtilities::Region<>& r)
+	{
+		for (const BUtilities::Area<>& a : r) cairo_rectangle (c, a.getX(), a.getY(), a.getWidth(), a.getHeight());
+	};
+
+	// Layer surfaces are kept until the window size changes
+	if 
+	(
+		backSurface_ && 
+		((cairo_image_surface_get_width (backSurface_) != width) || (cairo_image_surface_get_height (backSurface_) != height))
+	) destroyLayerSurfaces ();
+
+	for (std::map<int, cairo_surface_t*>::iterator it = layerSurfaces_.begin(); it != layerSurfaces_.end(); ++it)
+	{
+		cairo_surface_t* s = it->second;
+		if ((cairo_image_surface_get_width (s) != width) || (cairo_image_surface_get_height (s) != height))
+		{
+			destroyLayerSurfaces ();
+			break;
+		}
+
+		// Clear damaged areas. Directly if they match full pixels.
+		BUtilities::Region<> cairoRegion;
+		for (const BUtilities::Area<>& a : layerRegion)
+		{
+			if (!cairoplus_surface_clear_area (s, a.getX(), a.getY(), a.getWidth(), a.getHeight())) cairoRegion.add (a);
+		}
+
+		if (!cairoRegion.empty())
+		{
+			cairo_t* crs = cairo_create (s);
+			cairo_set_operator (crs, CAIRO_OPERATOR_CLEAR);
+			addPath (crs, cairoRegion);
+			cairo_fill (crs);
+			cairo_destroy (crs);
+		}
+	}
+
+	// Draw the damaged areas to the layer surfaces. Pin the widget surfaces
+	// used in this frame, so that they aren't released before they are 
+	// composed.
+	++surfaceList_.frame;
+	surfaceList_.pinned = true;
+	if (drawPool_) drawScheduled (layerRegion);
+	display (layerSurfaces_, BUtilities::Point<> (getWidth(), getHeight()), layerRegion);
+	surfaceList_.pinned = false;
+	enforceSurfaceBudget (surfaceList_);
+
+	// Compose layers from back to front. Skip composition for a single layer.
+	cairo_surface_t* source = nullptr;
+	if (layerSurfaces_.size() == 1) source = layerSurfaces_.begin()->second;
+	else if (layerSurfaces_.size() > 1)
+	{
+		if (!backSurface_) backSurface_ = createSurface (BUtilities::Point<> (getWidth(), getHeight()), getZoom());
+		source = backSurface_;
+
+		// Compose pixels directly if possible, otherwise use Cairo
+		BUtilities::Region<> cairoRegion;
+		for (const BUtilities::Area<>& a : layerRegion)
+		{
+			bool direct = cairoplus_surface_clear_area (backSurface_, a.getX(), a.getY(), a.getWidth(), a.getHeight());
+			for (std::map<int,cairo_surface_t*>::reverse_iterator rit = layerSurfaces_.rbegin(); direct && (rit != layerSurfaces_.rend()); ++rit)
+			{
+				cairo_surface_t* s = rit->second;
+				if (s && (cairo_surface_status (s) == CAIRO_STATUS_SUCCESS))
+				{
+					direct = cairoplus_surface_paint_area (backSurface_, a.getX(), a.getY(), a.getWidth(), a.getHeight(), s, 0.0, 0.0);
+				}
+			}
+			if (!direct) cairoRegion.add (a);
+		}
+
+		cairo_t* crb = (cairoRegion.empty() ? nullptr : cairo_create (backSurface_));
+		if (crb && (cairo_status (crb) == CAIRO_STATUS_SUCCESS))
+		{
+			addPath (crb, cairoRegion);
+			cairo_clip (crb);
+			cairo_set_operator (crb, CAIRO_OPERATOR_CLEAR);
+			cairo_paint (crb);
+			cairo_set_operator (crb, CAIRO_OPERATOR_OVER);
+
+			for (std::map<int,cairo_surface_t*>::reverse_iterator rit = layerSurfaces_.rbegin(); rit != layerSurfaces_.rend(); ++rit)
+			{
+				cairo_surface_t* s = rit->second;
+				if (s && (cairo_surface_status (s) == CAIRO_STATUS_SUCCESS))
+				{
+					cairo_set_source_surface (crb, s, 0.0, 0.0);
+					cairo_paint (crb);
+				}
+			}
+		}
+		if (crb) cairo_destroy (crb);
+	}
+
+	// Write the damaged areas to the host provided surface
+	if (source && (cairo_surface_status (source) == CAIRO_STATUS_SUCCESS))
+	{
+		// Source device scale and zoom cancel out: 1:1 pixel copy
+		cairo_save (cr);
+		addPath (cr, deviceRegion);
+		cairo_clip (cr);
+		cairo_scale (cr, getZoom(), getZoom());
+		cairo_set_source_surface (cr, source, 0.0, 0.0);
+		cairo_paint (cr);
+		cairo_restore (cr);
+	}
+}
+
+void Window::drawScheduled (const BUtilities::Region<>& region)
+{
+	// Collect visible widgets to be redrawn within region
+	validateHitIndex ();
+	drawWidgets_.clear();
+	for (const HitEntry& e : hitEntries_)
+	{
+		if (!e.widget->isDrawScheduled()) continue;
+
+		for (const BUtilities::Area<>& a : region)
+		{
+			BUtilities::Area<> i = e.area;
+			i.intersect (a);
+			if ((i != BUtilities::Area<> ()) && (!e.widget->isPreviewed()) && (!isOccluded (e.widget, i)) && e.widget->validateSurface ())
+			{
+				// Workers only read the tree cache and the last resolved 
+				// styles
+				e.widget->validateTreeCache ();
+				if (e.widget->isConcurrentDraw()) drawWidgets_.push_back (e.widget);
+				else e.widget->redraw ();
+				break;
+			}
+		}
+	}
+
+	drawPool_->parallelFor (drawWidgets_.size(), [this] (size_t i) {drawWidgets_[i]->redraw ();});
+	drawWidgets_.clear();
+}
+
+void Window::createOffscreenSurface ()
+{
+	destroyOffscreenSurface ();
+	const int width = std::max (static_cast<int> (std::ceil (getWidth() * getZoom())), 1);
+	const int height = std::max (static_cast<int> (std::ceil (getHeight() * getZoom())), 1);
+	offscreenSurface_ = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, height);
+	offscreenContext_ = cairo_create (offscreenSurface_);
+}
+
+void Window::destroyOffscreenSurface ()
+{
+	if (offscreenContext_) cairo_destroy (offscreenContext_);
+	if (offscreenSurface_) cairo_surface_destroy (offscreenSurface_);
+	offscreenContext_ = nullptr;
+	offscreenSurface_ = nullptr;
+}
+
+void Window::destroyLayerSurfaces ()
+{
+	for (std::map<int, cairo_surface_t*>::iterator it = layerSurfaces_.begin(); it != layerSurfaces_.end(); ++it)
+	{
+		if (it->second) cairo_surface_destroy (it->second);
+	}
+	layerSurfaces_.clear();
+
+	if (backSurface_) cairo_surface_destroy (backSurface_);
+	backSurface_ = nullptr;
+}
+
 void Window::translateTimeEvent ()
 {
 	std::list<Widget*> gwidgets = listDeviceGrabbed (BDevices::MouseButton (BDevices::MouseButton::ButtonType::none));
@@ -851,13 +1713,13 @@ void Window::translateTimeEvent ()
 
 				if ((!focused_) && focus->isFocusActive (diffMs))
 				{
-					addEventToQueue (new BEvents::PointerFocusEvent (widget, BEvents::Event::EventType::pointerFocusInEvent, position));
+					addEventToQueue (createEvent<BEvents::PointerFocusEvent> (widget, BEvents::Event::EventType::pointerFocusInEvent, position));
 					focused_ = true;
 				}
 
 				else if (focused_ && (!focus->isFocusActive (diffMs)))
 				{
-					addEventToQueue (new BEvents::PointerFocusEvent (widget, BEvents::Event::EventType::pointerFocusOutEvent, position));
+					addEventToQueue (createEvent<BEvents::PointerFocusEvent> (widget, BEvents::Event::EventType::pointerFocusOutEvent, position));
 					focused_ = false;
 				}
 			}
@@ -881,7 +1743,7 @@ void Window::unfocus ()
 				if (focus)
 				{
 					BUtilities::Point<> position = (mdev ? mdev->getPosition() : BUtilities::Point<> ());
-					addEventToQueue (new BEvents::PointerFocusEvent (widget, BEvents::Event::EventType::pointerFocusOutEvent, position));
+					addEventToQueue (createEvent<BEvents::PointerFocusEvent> (widget, BEvents::Event::EventType::pointerFocusOutEvent, position));
 				}
 			}
 		}
@@ -889,36 +1751,152 @@ void Window::unfocus ()
 	}
 }
 
-void Window::purgeEventQueue (Widget* widget)
+void Window::postRedisplay ()
 {
-	for (std::list<BEvents::Event*>::iterator it = eventQueue_.begin (); it != eventQueue_.end (); /* empty */)
+	if (exposeRegion_.empty()) return;
+
+	// Hidden window: Nothing to post. The host system exposes the whole 
+	// window once shown.
+	if (!isVisible())
 	{
-		BEvents::Event* event = *it;
-		if
+		exposeRegion_.clear();
+		return;
+	}
+
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (now < nextFrame_) return;
+
+	// Post each area in full pixels, limited to the window
+	const double width = std::ceil (getWidth() * getZoom());
+	const double height = std::ceil (getHeight() * getZoom());
+	for (const BUtilities::Area<>& a : exposeRegion_)
+	{
+		const double x0 = std::max (std::floor (a.getX() * getZoom()), 0.0);
+		const double y0 = std::max (std::floor (a.getY() * getZoom()), 0.0);
+		const double x1 = std::min (std::ceil ((a.getX() + a.getWidth()) * getZoom()), width);
+		const double y1 = std::min (std::ceil ((a.getY() + a.getHeight()) * getZoom()), height);
+		if ((x1 <= x0) || (y1 <= y0)) continue;
+
+		if (view_) puglPostRedisplayRect (view_,	{static_cast<PuglCoord>(x0), 
+													 static_cast<PuglCoord>(y0), 
+													 static_cast<PuglSpan>(x1 - x0), 
+													 static_cast<PuglSpan>(y1 - y0)});
+		redisplayRegion_.add (BUtilities::Area<> (x0, y0, x1 - x0, y1 - y0));
+	}
+	exposeRegion_.clear();
+	if (frameRate_ > 0.0) nextFrame_ = now + std::chrono::duration_cast<std::chrono::steady_clock::duration> (std::chrono::duration<double> (1.0 / frameRate_));
+
+	// Offscreen: No host system. Expose immediately.
+	if (isOffscreen() && (!redisplayRegion_.empty()))
+	{
+		const BUtilities::Area<> a = redisplayRegion_.getBoundingBox();
+		PuglEvent event {};
+		event.expose.type = PUGL_EXPOSE;
+		event.expose.x = static_cast<PuglCoord> (a.getX());
+		event.expose.y = static_cast<PuglCoord> (a.getY());
+		event.expose.width = static_cast<PuglSpan> (a.getWidth());
+		event.expose.height = static_cast<PuglSpan> (a.getHeight());
+		translateEvent (&event);
+	}
+}
+
+void Window::drainInbox ()
+{
+	InboxEntry entry;
+	bool drained = false;
+	while (inbox_.pop (entry)) 
+	{
+		inboxPending_.push_back (entry);
+		drained = true;
+	}
+
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (drained) inboxTime_ = now;
+
+	// Stop polling once the inbox stayed empty for a while
+	else if 
+	(
+		inboxUsed_.load (std::memory_order_relaxed) && 
+		(now - inboxTime_ >= std::chrono::milliseconds (BWIDGETS_DEFAULT_INBOX_IDLE_TIME))
+	)
+	{
+		// Producers push before they set the flag (with a fence in between).
+		// Thus, an entry pushed in the meantime is either found by the next
+		// inbox_.empty() (see getWakeupTimeout()) or sets the flag again.
+		inboxUsed_.store (false, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_seq_cst);
+	}
+}
+
+void Window::processInbox ()
+{
+	if (inboxPending_.empty()) return;
+
+	// Entries injected in the meantime (e.g., by a callback) are left to the
+	// next call
+	inboxProcessing_.swap (inboxPending_);
+
+	// Index the latest value for each widget and value type
+	for (size_t i = 0; i < inboxProcessing_.size(); ++i)
+	{
+		const InboxEntry& entry = inboxProcessing_[i];
+		if (!entry.name) inboxIndex_[InboxKey {entry.widget, entry.apply}] = i;
+	}
+
+	// Apply messages and the latest values
+	for (size_t i = 0; i < inboxProcessing_.size(); ++i)
+	{
+		const InboxEntry& entry = inboxProcessing_[i];
+		if (entry.widget && (entry.name || (inboxIndex_[InboxKey {entry.widget, entry.apply}] == i))) entry.apply (entry);
+	}
+
+	inboxIndex_.clear();
+	inboxProcessing_.clear();
+}
+
+void Window::purgeEventQueue (Widget* widget)
+{
+	drainInbox ();
+	inboxPending_.erase
+	(
+		std::remove_if 
 		(
-			(event) &&
+			inboxPending_.begin(), 
+			inboxPending_.end(), 
+			[widget] (const InboxEntry& entry) {return (widget == nullptr) || (widget == entry.widget);}
+		),
+		inboxPending_.end()
+	);
+	for (InboxEntry& entry : inboxProcessing_)
+	{
+		if ((widget == nullptr) || (widget == entry.widget)) entry.widget = nullptr;
+	}
+
+	removeEvents
+	(
+		[widget] (BEvents::Event* event)
+		{
+			return
 			(
-				// Nullptr = joker
-				(widget == nullptr) ||
-				// Hit
-				(widget == event->getWidget ()) ||
+				(event) &&
 				(
-					// Hit in request widgets
+					// Nullptr = joker
+					(widget == nullptr) ||
+					// Hit
+					(widget == event->getWidget ()) ||
 					(
-						(static_cast<uint32_t>(event->getEventType ()) & static_cast<uint32_t>(BEvents::Event::EventType::configureRequestEvent)) ||
-						(static_cast<uint32_t>(event->getEventType ()) & static_cast<uint32_t>(BEvents::Event::EventType::exposeRequestEvent)) ||
-						(static_cast<uint32_t>(event->getEventType ()) & static_cast<uint32_t>(BEvents::Event::EventType::closeRequestEvent))
-					) &&
-					(widget == ((BEvents::WidgetEvent*)event)->getRequestWidget ())
+						// Hit in request widgets
+						(
+							(static_cast<uint32_t>(event->getEventType ()) & static_cast<uint32_t>(BEvents::Event::EventType::configureRequestEvent)) ||
+							(static_cast<uint32_t>(event->getEventType ()) & static_cast<uint32_t>(BEvents::Event::EventType::exposeRequestEvent)) ||
+							(static_cast<uint32_t>(event->getEventType ()) & static_cast<uint32_t>(BEvents::Event::EventType::closeRequestEvent))
+						) &&
+						(widget == ((BEvents::WidgetEvent*)event)->getRequestWidget ())
+					)
 				)
-			)
-		)
-		{
-			it = eventQueue_.erase (it);
-			delete event;
+			);
 		}
-		else ++it;
-	}
+	);
 }
 
 bool Window::isQuit() const
@@ -21,11 +21,26 @@
 // Default BWidgets::Window settings (Note: use non-transparent backgrounds only)
 #define BWIDGETS_DEFAULT_WINDOW_BACKGROUND BStyles::blackFill
 
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "Widget.hpp"
 #include "pugl/pugl.h"
 #include "Supports/Closeable.hpp"
 #include "Supports/EventQueueable.hpp"
+#include "Supports/Messagable.hpp"
+#include "../BUtilities/Any.hpp"
+#include "../BUtilities/MpscQueue.hpp"
+#include "../BUtilities/ThreadPool.hpp"
 
 #ifndef BWIDGETS_DEFAULT_WINDOW_WIDTH
 #define BWIDGETS_DEFAULT_WINDOW_WIDTH 600
@@ -35,9 +50,39 @@
 #define BWIDGETS_DEFAULT_WINDOW_HEIGHT 400
 #endif
 
+#ifndef BWIDGETS_DEFAULT_FRAME_RATE
+#define BWIDGETS_DEFAULT_FRAME_RATE 60.0
+#endif
+
+#ifndef BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE
+#define BWIDGETS_DEFAULT_HIT_GRID_CELL_SIZE 32.0
+#endif
+
+#ifndef BWIDGETS_DEFAULT_DRAW_THREADS
+#define BWIDGETS_DEFAULT_DRAW_THREADS 0
+#endif
+
+#ifndef BWIDGETS_DEFAULT_RESIZE_SETTLE_TIME
+#define BWIDGETS_DEFAULT_RESIZE_SETTLE_TIME 150
+#endif
+
+#ifndef BWIDGETS_DEFAULT_INBOX_SIZE
+#define BWIDGETS_DEFAULT_INBOX_SIZE 1024
+#endif
+
+#ifndef BWIDGETS_DEFAULT_INBOX_DATA_SIZE
+#define BWIDGETS_DEFAULT_INBOX_DATA_SIZE 32
+#endif
+
+#ifndef BWIDGETS_DEFAULT_INBOX_IDLE_TIME
+#define BWIDGETS_DEFAULT_INBOX_IDLE_TIME 1000
+#endif
+
 namespace BWidgets
 {
 
+template <class T> class ValueableTyped;
+
 /**
  *  @brief  Main %Window class of BWidgets.
  *
@@ -64,15 +109,127 @@ namespace BWidgets
  */
 class Window : public Widget, public EventQueueable, public Closeable
 {
+	friend class Widget;
+
+public:
+
+	/**
+	 *  @brief  Main loop statistics.
+	 *
+	 *  Counted since construction or the last call of 
+	 *  @c resetLoopStatistics() .
+	 */
+	struct LoopStatistics
+	{
+		uint64_t wakeups;
+		uint64_t frames;
+		double wakeupsPerSecond;
+		double framesPerSecond;
+		std::chrono::duration<double> blockedTime;
+		std::chrono::duration<double> busyTime;
+	};
+
+	/**
+	 *  @brief  Pair of a filter function and a pass function for
+	 *  @c getWidgetsAt() .
+	 */
+	typedef std::pair<std::function<bool (Widget* widget)>, std::function<bool (Widget* widget)>> WidgetFilter;
+
+	/**
+	 *  @brief  Tag type to construct an offscreen %Window.
+	 */
+	struct Offscreen {};
+
 protected:
 	double zoom_;
 	PuglWorld* world_;
 	PuglWorldType worldType_;
 	PuglView* view_;
 	PuglNativeView nativeWindow_;
+	cairo_surface_t* offscreenSurface_;
+	cairo_t* offscreenContext_;
 	bool quit_;
 	bool focused_;
 	BUtilities::Point<> pointer_;
+	double frameRate_;
+	std::chrono::steady_clock::time_point nextFrame_;
+	std::chrono::steady_clock::time_point wakeup_;
+	BUtilities::Region<> exposeRegion_;
+	BUtilities::Region<> redisplayRegion_;
+	std::map<int, cairo_surface_t*> layerSurfaces_;
+	cairo_surface_t* backSurface_;
+	std::unique_ptr<BUtilities::ThreadPool> drawPool_;
+	std::vector<Widget*> drawWidgets_;
+	Visualizable::SurfaceList surfaceList_;
+	bool resizing_;
+	std::chrono::steady_clock::time_point resizeTime_;
+	uint64_t loopWakeups_;
+	uint64_t loopFrames_;
+	std::chrono::steady_clock::time_point loopStart_;
+	std::chrono::duration<double> loopBlocked_;
+	std::chrono::duration<double> loopBusy_;
+	std::unordered_map<uint64_t, std::vector<Widget*>> deviceGrabs_;
+
+	struct HitEntry
+	{
+		Widget* widget;
+		size_t parent;
+		size_t end;
+		int layer;
+		BUtilities::Point<> position;
+		BUtilities::Area<> area;
+	};
+
+	std::vector<HitEntry> hitEntries_;
+	std::unordered_map<const Widget*, size_t> hitEntryIndex_;
+	std::vector<std::vector<size_t>> hitGrid_;
+	BUtilities::Area<> hitGridArea_;
+	size_t hitGridColumns_;
+	size_t hitGridRows_;
+	bool hitIndexValid_;
+	std::vector<size_t> hitIndexUpdates_;
+	std::vector<size_t> hitOpaqueEntries_;
+	std::vector<BUtilities::Area<>> occlusionRest_;
+	std::vector<BUtilities::Area<>> occlusionNext_;
+	bool stylesValid_;
+	bool stylesValidating_;
+	bool styleExposeCovered_;
+	Widget::StyleRecords styleRecords_;
+	BUtilities::Area<> styleExposeArea_;
+
+	struct InboxEntry
+	{
+		Widget* widget;
+		void (*apply) (const InboxEntry& entry);
+		const char* name;
+		alignas (std::max_align_t) unsigned char data[BWIDGETS_DEFAULT_INBOX_DATA_SIZE];
+	};
+
+	struct InboxKey
+	{
+		const Widget* widget;
+		void (*apply) (const InboxEntry& entry);
+
+		bool operator== (const InboxKey& that) const
+		{
+			return (widget == that.widget) && (apply == that.apply);
+		}
+	};
+
+	struct InboxKeyHash
+	{
+		size_t operator() (const InboxKey& key) const
+		{
+			return std::hash<const Widget*>() (key.widget) ^ (std::hash<void*>() (reinterpret_cast<void*> (key.apply)) * 0x9e3779b9u);
+		}
+	};
+
+	BUtilities::MpscQueue<InboxEntry> inbox_;
+	std::atomic<bool> inboxUsed_;
+	std::chrono::steady_clock::time_point inboxTime_;
+	std::vector<InboxEntry> inboxPending_;
+	std::vector<InboxEntry> inboxProcessing_;
+	std::unordered_map<InboxKey, size_t, InboxKeyHash> inboxIndex_;
 
 public:
 
@@ -104,6 +261,25 @@ public:
 		uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "BWidgets", bool resizable = false,
 		PuglWorldType worldType = PUGL_PROGRAM, int worldFlag = 0);
 
+	/**
+	 *  @brief  Construct an offscreen %Window object.
+	 *  @param width  Window width.
+	 *  @param height  Window height.
+	 *  @param offscreen  Offscreen tag.
+	 *  @param urid  Optional, URID (default = BUTILITIES_URID_UNKNOWN_URID).
+	 *  @param title  Optional, Window title.
+	 *
+	 *  An offscreen %Window doesn't connect to the host system. It runs the
+	 *  same event queue and composition as an onscreen %Window, but into an
+	 *  in-memory image surface (see @c getOffscreenSurface() ). Host events
+	 *  can be emulated by @c sendEvent() . Frames are composed without frame
+	 *  rate limit and without resize settling within @c handleEvents() .
+	 *  Thus, rendering is deterministic and doesn't need a display server
+	 *  (e.g., for benchmarks and regression tests).
+	 */
+	Window (const double width, const double height, Offscreen offscreen,
+		uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "BWidgets");
+
 	virtual ~Window ();
 
 	/**
@@ -126,9 +302,46 @@ public:
 	 * 
 	 * @param device  Device
 	 * @return  List of all widgets with device grabbed
+	 *
+	 * Device grabs are registered by the widgets (see 
+	 * @c Widget::grabDevice() ). Thus, the lookup doesn't depend on the
+	 * number of linked widgets.
 	 */
 	std::list<Widget*> listDeviceGrabbed (const BDevices::Device& device) const;
 
+	/**
+	 *  @brief  Gets the top %Widget at a given position.
+	 *  @param position  Position. 
+	 *  @param func  Optional, filter function.
+	 *  @param passfunc  Optional, function to skip this widget and continue
+	 *  with the widget below.
+	 *  @return  Pointer to the %Widget.
+	 *
+	 *  Same as @c Widget::getWidgetAt() , but uses a spatial index of all 
+	 *  visible linked widgets (see @c getWidgetsAt() ).
+	 */
+	virtual Widget* getWidgetAt	(const BUtilities::Point<>& position, 
+								 std::function<bool (Widget* widget)> func = [] (Widget* widget) {return true;},
+								 std::function<bool (Widget* widget)> passfunc = [] (Widget* widget) {return false;}) override;
+
+	/**
+	 *  @brief  Gets the top widgets at a given position for multiple filters
+	 *  at once.
+	 *  @param position  Position. 
+	 *  @param filters  Vector of pairs of filter functions and pass 
+	 *  functions (see @c Widget::getWidgetAt() ).
+	 *  @return  Vector of pointers to the top widget for each filter (or 
+	 *  nullptr).
+	 *
+	 *  Uses a grid-based spatial index of the (clipped) absolute areas of all
+	 *  visible linked widgets. The index is rebuilt upon structural changes
+	 *  (e.g., @c add() , @c release() , @c show() , @c hide() , @c raise() )
+	 *  and incrementally updated upon geometric changes ( @c moveTo() ,
+	 *  @c resize() ). Widgets at @a position are collected once and then
+	 *  evaluated for each filter.
+	 */
+	std::vector<Widget*> getWidgetsAt (const BUtilities::Point<>& position, const std::vector<WidgetFilter>& filters);
+
 	/**
 	 *  @brief  Sets the zoom factor visualization and user interaction.
 	 *  @param zoom  Zoom factor.
@@ -156,16 +369,211 @@ public:
 	/**
 	 *  @brief  Gets the Cairo context provided by the host system via Pugl.
 	 *  @return  Pointer to the Cairo context.
+	 *
+	 *  Offscreen windows return the context of the offscreen surface.
 	 */
 	cairo_t* getCairoContext ();
 
+	/**
+	 *  @brief  Information whether the %Window is an offscreen %Window.
+	 *  @return  True if offscreen, otherwise false.
+	 */
+	bool isOffscreen () const;
+
+	/**
+	 *  @brief  Gets the offscreen surface.
+	 *  @return  Pointer to the Cairo image surface or nullptr if not
+	 *  offscreen.
+	 *
+	 *  The surface size is the window size multiplied by the zoom factor
+	 *  in device pixels. The surface is re-created upon resize or zoom.
+	 */
+	cairo_surface_t* getOffscreenSurface ();
+
+	/**
+	 *  @brief  Writes the content of the offscreen surface to a PNG file.
+	 *  @param filename  File name.
+	 *  @return  True on success, otherwise false.
+	 */
+	bool writeToPng (const std::string& filename);
+
+	/**
+	 *  @brief  Emulates a host system event.
+	 *  @param event  PuglEvent (in device pixels).
+	 *
+	 *  The event is translated in the same way as a host-provided event and
+	 *  the resulting events are added to the event queue. Not thread-safe.
+	 *  Call from the UI thread only.
+	 */
+	void sendEvent (const PuglEvent& event);
+
+	/**
+	 *  @brief  Emulates a host system pointer button event.
+	 *  @param position  Pointer position.
+	 *  @param button  Pugl button number (0 = left).
+	 *  @param press  True for press, false for release.
+	 */
+	void sendButtonEvent (const BUtilities::Point<>& position, const uint32_t button, const bool press);
+
+	/**
+	 *  @brief  Emulates a host system pointer motion event.
+	 *  @param position  Pointer position.
+	 */
+	void sendMotionEvent (const BUtilities::Point<>& position);
+
+	/**
+	 *  @brief  Emulates a host system scroll event.
+	 *  @param position  Pointer position.
+	 *  @param delta  Scroll distance.
+	 */
+	void sendScrollEvent (const BUtilities::Point<>& position, const BUtilities::Point<>& delta);
+
+	/**
+	 *  @brief  Emulates a host system key event.
+	 *  @param key  Unicode character or PuglKey.
+	 *  @param press  True for press, false for release.
+	 *
+	 *  Character key presses are also sent as text events.
+	 */
+	void sendKeyEvent (const uint32_t key, const bool press);
+
+	/**
+	 *  @brief  Emulates a host system configure event.
+	 *  @param extends  New window extends.
+	 */
+	void sendConfigureEvent (const BUtilities::Point<>& extends);
+
+	/**
+	 *  @brief  Sets the maximum frame rate for redisplaying.
+	 *  @param fps  Frames per second or 0.0 for unlimited.
+	 *
+	 *  Expose requests are collected and posted to the host system at most
+	 *  once per frame.
+	 */
+	virtual void setFrameRate (const double fps);
+
+	/**
+	 *  @brief  Gets the maximum frame rate for redisplaying.
+	 *  @return  Frames per second or 0.0 if unlimited.
+	 */
+	double getFrameRate () const;
+
+	/**
+	 *  @brief  Sets the number of worker threads for parallel drawing.
+	 *  @param threads  Number of worker threads or 0 to draw in the UI 
+	 *  thread only (default, see BWIDGETS_DEFAULT_DRAW_THREADS).
+	 *
+	 *  If enabled, the widgets which need to be redrawn for an expose are
+	 *  collected first and then drawn in parallel by a work-stealing pool
+	 *  of worker threads and the UI thread. Widgets which don't allow 
+	 *  concurrent drawing (see @c Visualizable::setConcurrentDraw() ) are
+	 *  drawn in the UI thread before. Composition of the widget surfaces
+	 *  always takes place in the UI thread.
+	 */
+	void setDrawThreads (const size_t threads);
+
+	/**
+	 *  @brief  Gets the number of worker threads for parallel drawing.
+	 *  @return  Number of worker threads.
+	 */
+	size_t getDrawThreads () const;
+
+	/**
+	 *  @brief  Sets the memory budget for the Cairo surfaces of the widgets
+	 *  linked to this %Window.
+	 *  @param bytes  Budget in bytes or 0 for an unlimited budget (default,
+	 *  see BWIDGETS_DEFAULT_SURFACE_BUDGET).
+	 *
+	 *  Least recently used surfaces are released if the total size of the
+	 *  surfaces exceeds the budget. Surfaces used for the current frame are
+	 *  released not before the frame is composed. Each %Window has its own 
+	 *  budget.
+	 */
+	void setSurfaceBudget (const size_t bytes);
+
+	/**
+	 *  @brief  Gets the memory budget for the Cairo surfaces of the widgets
+	 *  linked to this %Window.
+	 *  @return  Budget in bytes or 0 if unlimited.
+	 */
+	size_t getSurfaceBudget () const;
+
+	/**
+	 *  @brief  Gets the memory size of all allocated Cairo surfaces of the
+	 *  widgets linked to this %Window.
+	 *  @return  Size in bytes.
+	 */
+	size_t getTotalSurfaceBytes () const;
+
+	/**
+	 *  @brief  Information whether the window is interactively resized.
+	 *  @return  True if the window size changed within the last
+	 *  BWIDGETS_DEFAULT_RESIZE_SETTLE_TIME milliseconds, otherwise false.
+	 *
+	 *  While the window is resized, widgets which have been resized since
+	 *  their last draw are not redrawn but displayed as a scaled preview of
+	 *  their previous content. Surface re-allocation and redraw are deferred
+	 *  until the resize settles. Then the whole window is redisplayed.
+	 */
+	bool isResizing () const;
+
+	/**
+	 *  @brief  Schedules a wakeup of the main loop.
+	 *  @param time  Time point to wake up.
+	 *
+	 *  Widgets with time-dependent content (e. g., animations) may call this
+	 *  method to be served in time by a blocking main loop (see @c run() ).
+	 *  Only the earliest scheduled wakeup is kept.
+	 */
+	void scheduleWakeup (const std::chrono::steady_clock::time_point& time);
+
+	/**
+	 *  @brief  Gets the time until the next scheduled action of the main 
+	 *  loop.
+	 *  @return  Timeout in seconds, 0.0 if there are events to be handled
+	 *  or -1.0 if nothing is scheduled.
+	 *
+	 *  Scheduled actions are queued events, pending redisplays, pointer focus
+	 *  in and out timeouts, and wakeups requested by @c scheduleWakeup() .
+	 *  While other threads inject values or messages (see @c injectValue() ),
+	 *  the inbox is polled once per frame. Polling stops once the inbox 
+	 *  stayed empty for BWIDGETS_DEFAULT_INBOX_IDLE_TIME milliseconds and 
+	 *  restarts with the next wakeup after a new injection.
+	 */
+	double getWakeupTimeout () const;
+
+	/**
+	 *  @brief  Gets the main loop statistics.
+	 *  @return  LoopStatistics.
+	 */
+	LoopStatistics getLoopStatistics () const;
+
+	/**
+	 *  @brief  Resets the main loop statistics.
+	 */
+	void resetLoopStatistics ();
+
 	/**
 	 *  @brief  Runs the %Window until it get closed.
 	 *
-	 *  For stand-alone applications.
+	 *  For stand-alone applications. Blocks (see @c waitEvents() ) until
+	 *  there is something to do and then calls @c handleEvents() .
 	 */
 	virtual void run ();
 
+	/**
+	 *  @brief  Waits for host system events.
+	 *
+	 *  Blocks until host system events arrive or until the timeout given by
+	 *  @c getWakeupTimeout() is passed. Host system events are translated
+	 *  and added to the event queue.
+	 *
+	 *  Offscreen windows sleep until the timeout is passed. If nothing is
+	 *  scheduled, they sleep for one frame (see @c setFrameRate() ) and 
+	 *  then return to poll values injected by other threads.
+	 */
+	virtual void waitEvents ();
+
 	/**
 	 *  @brief  Queues an event until the next call of the @c handleEvents() 
 	 *  method.
@@ -180,7 +588,8 @@ public:
 	 *  2. must NOT be deleted outside once it is passed to the Window object.
 	 *
 	 *  Also tries to merge the @a event
-	 *  with the previous event of the queue if:
+	 *  with the latest queued event of the same widget and of the same type
+	 *  (constant time lookup) if:
 	 *  1. Both events are the same type.
 	 *  2. The event type is eligible for merging.
 	 *  3. Both events are emitted by the same widget.
@@ -193,10 +602,61 @@ public:
 	 *  @brief  Main Event handler. 
 	 *
 	 *  Iterates through the event queue, analyzes the events, and and routes
-	 *  them to their respective @c onXXX() handling methods.
+	 *  them to their respective @c onXXX() handling methods. Doesn't block.
+	 *  Can be called periodically (e.g., by a plugin host) instead of 
+	 *  @c run() .
 	 */
 	virtual void handleEvents ();
 
+	/**
+	 *  @brief  Injects a new value for a widget from any thread.
+	 *  @tparam T  Value type of the widget (see ValueableTyped). Must be
+	 *  trivially copyable and not larger than 
+	 *  BWIDGETS_DEFAULT_INBOX_DATA_SIZE.
+	 *  @param widget  Pointer to a ValueableTyped<T> widget linked to this
+	 *  %Window.
+	 *  @param value  New value.
+	 *  @return  True on success, false if the inbox is full.
+	 *
+	 *  Thread-safe, lock-free (but not wait-free, see 
+	 *  BUtilities::MpscQueue ) and doesn't allocate memory. Thus, it can be
+	 *  called from realtime threads (e.g., a DSP thread). Injected values are
+	 *  collected in the inbox and passed to the widget by 
+	 *  @c ValueableTyped<T>::setValue() within the next call of
+	 *  @c handleEvents() . Multiple values injected for the same widget 
+	 *  before are coalesced to the latest value.
+	 *
+	 *  Note: A blocking main loop (see @c run() ) polls the inbox once per
+	 *  frame as long as values or messages are injected. If the inbox stayed
+	 *  empty for BWIDGETS_DEFAULT_INBOX_IDLE_TIME milliseconds, the loop 
+	 *  blocks again and a new injection is taken up with the next wakeup
+	 *  (e.g., a host system event or a scheduled wakeup).
+	 *
+	 *  Note: The caller is responsible for not injecting values to widgets
+	 *  which are (about to be) destructed.
+	 */
+	template <class T>
+	bool injectValue (Widget* widget, const T& value);
+
+	/**
+	 *  @brief  Injects a message for a widget from any thread.
+	 *  @tparam T  Content type. Must be trivially copyable and not larger 
+	 *  than BWIDGETS_DEFAULT_INBOX_DATA_SIZE.
+	 *  @param widget  Pointer to a Messagable widget linked to this %Window.
+	 *  @param name  Message name. Must be a string with static storage 
+	 *  duration (e.g., a string literal).
+	 *  @param content  Message content.
+	 *  @return  True on success, false if the inbox is full.
+	 *
+	 *  Thread-safe, lock-free (but not wait-free) and doesn't allocate 
+	 *  memory. Polled like injected values (see @c injectValue() ). Injected 
+	 *  messages are passed in the order of injection to @c Messagable::postMessage()
+	 *  within the next call of @c handleEvents() . Messages are not 
+	 *  coalesced.
+	 */
+	template <class T>
+	bool injectMessage (Widget* widget, const char* name, const T& content);
+
 	/**
 	 *  @brief  Method called upon an expose request event. Exposes the visual 
 	 *  content.
@@ -206,7 +666,9 @@ public:
 	 *  This method calls the host system to emit a host-provided expose event
 	 *  which is then interpreted in the @c translatePuglEvent() method where
 	 *  it calls drawing of all linked child widget RGBA surfaces to the host
-	 *  provided RGBA surface.
+	 *  provided RGBA surface. Expose requests are collected and passed to the
+	 *  host system not more often than defined by the frame rate (see 
+	 *  @c setFrameRate() ).
 	 */
 	virtual void onExposeRequest (BEvents::Event* event) override;
 
@@ -239,6 +701,10 @@ public:
 	bool isQuit () const;
 
 private:
+	Window (const double width, const double height, PuglNativeView nativeWindow, 
+		uint32_t urid, std::string title, bool resizable,
+		PuglWorldType worldType, int worldFlag, bool offscreen);
+
 	/**
 	 *  @brief  Static event translation method to be called by Pugl.
 	 *  @param view  Pointer to the PuglView.
@@ -256,11 +722,113 @@ private:
 	 */
 	static PuglStatus translatePuglEvent (PuglView* view, const PuglEvent* event);
 
+	PuglStatus translateEvent (const PuglEvent* event);
+
 	void translateTimeEvent ();
 
 	void unfocus();
+
+	void postRedisplay ();
+
+	void exposeLayers (cairo_t* cr, const BUtilities::Region<>& region);
+
+	void destroyLayerSurfaces ();
+
+	void createOffscreenSurface ();
+
+	void destroyOffscreenSurface ();
+
+	void drawScheduled (const BUtilities::Region<>& region);
+
+	void addDeviceGrab (Widget* widget, const BDevices::Device& device);
+
+	void removeDeviceGrab (Widget* widget, const BDevices::Device& device);
+
+	void invalidateHitIndex ();
+
+	void updateHitIndex (const Widget* widget);
+
+	void validateHitIndex ();
+
+	void buildHitIndex (Widget* widget, const size_t parent, const BUtilities::Area<>& outerArea);
+
+	void insertHitEntry (const size_t index);
+
+	void removeHitEntry (const size_t index);
+
+	bool isOccluded (const Widget* widget, const BUtilities::Area<>& area, const bool family = false);
+
+	void validateStyles ();
+
+	bool validateStyles (Widget* widget, const bool covered);
+
+	void drainInbox ();
+
+	void processInbox ();
+
+	template <class T>
+	static void applyInboxValue (const InboxEntry& entry);
+
+	template <class T>
+	static void applyInboxMessage (const InboxEntry& entry);
 };
 
+template <class T>
+inline bool Window::injectValue (Widget* widget, const T& value)
+{
+	static_assert (std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+	static_assert (sizeof (T) <= BWIDGETS_DEFAULT_INBOX_DATA_SIZE, "T exceeds BWIDGETS_DEFAULT_INBOX_DATA_SIZE");
+	static_assert (alignof (T) <= alignof (std::max_align_t), "Over-aligned types are not supported");
+
+	InboxEntry entry;
+	entry.widget = widget;
+	entry.apply = &Window::applyInboxValue<T>;
+	entry.name = nullptr;
+	std::memcpy (entry.data, &value, sizeof (T));
+	const bool pushed = inbox_.push (entry);
+
+	// Push first, then (re-)start polling. See drainInbox().
+	std::atomic_thread_fence (std::memory_order_seq_cst);
+	inboxUsed_.store (true, std::memory_order_relaxed);
+	return pushed;
+}
+
+template <class T>
+inline bool Window::injectMessage (Widget* widget, const char* name, const T& content)
+{
+	static_assert (std::is_trivially_copyable<T>::value, "T must be trivially copyable");
+	static_assert (sizeof (T) <= BWIDGETS_DEFAULT_INBOX_DATA_SIZE, "T exceeds BWIDGETS_DEFAULT_INBOX_DATA_SIZE");
+	static_assert (alignof (T) <= alignof (std::max_align_t), "Over-aligned types are not supported");
+
+	InboxEntry entry;
+	entry.widget = widget;
+	entry.apply = &Window::applyInboxMessage<T>;
+	entry.name = name;
+	std::memcpy (entry.data, &content, sizeof (T));
+	const bool pushed = inbox_.push (entry);
+
+	// Push first, then (re-)start polling. See drainInbox().
+	std::atomic_thread_fence (std::memory_order_seq_cst);
+	inboxUsed_.store (true, std::memory_order_relaxed);
+	return pushed;
+}
+
+template <class T>
+inline void Window::applyInboxValue (const InboxEntry& entry)
+{
+	ValueableTyped<T>* v = dynamic_cast<ValueableTyped<T>*> (entry.widget);
+	if (!v) return;
+	v->setValue (*reinterpret_cast<const T*> (entry.data));
+}
+
+template <class T>
+inline void Window::applyInboxMessage (const InboxEntry& entry)
+{
+	Messagable* m = dynamic_cast<Messagable*> (entry.widget);
+	if (!m) return;
+	m->postMessage (entry.name ? entry.name : "", BUtilities::makeAny<T> (*reinterpret_cast<const T*> (entry.data)));
+}
+
 }
 
 
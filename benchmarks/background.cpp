@@ -0,0 +1,172 @@
+/* background.cpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Benchmark: Per-widget background cost. Draws 1000 widgets (64 x 32) with
+// different background and border styles for several rounds. Results are
+// written as JSON to stdout (or to the file passed as first argument):
+// * expected_path: expected (not measured) drawing path ("pixels" for direct
+//   pixel fills, "cairo" for Cairo paths),
+// * us_per_widget: mean time of a full Widget::draw() in microseconds,
+// * mpixels_per_s: drawn million pixels per second.
+
+#include "../BWidgets/Widget.hpp"
+#include "../BStyles/Types/Border.hpp"
+#include "../BStyles/Types/Fill.hpp"
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace BWidgets;
+
+class BackgroundWidget : public Widget
+{
+public:
+    using Widget::Widget;
+
+    bool prepare () {return validateSurface ();}
+
+    void drawBackground () {draw ();}
+};
+
+struct Result
+{
+    std::string name;
+    std::string expectedPath;
+    double usPerWidget;
+    double mpixelsPerSecond;
+};
+
+static Result measure (const std::string& name, const std::string& expectedPath, const double width, const double height, std::function<void (Widget& widget)> style)
+{
+    const size_t count = 1000;
+    const size_t rounds = 50;
+    std::vector<std::unique_ptr<BackgroundWidget>> widgets;
+    for (size_t i = 0; i < count; ++i)
+    {
+        widgets.push_back (std::unique_ptr<BackgroundWidget> (new BackgroundWidget (0, 0, width, height)));
+        style (*widgets.back());
+        widgets.back()->prepare();
+        widgets.back()->drawBackground();
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < rounds; ++r)
+    {
+        for (std::unique_ptr<BackgroundWidget>& w : widgets) w->drawBackground();
+    }
+    const double total = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+
+    Result result;
+    result.name = name;
+    result.expectedPath = expectedPath;
+    result.usPerWidget = 1000000.0 * total / (count * rounds);
+    result.mpixelsPerSecond = (total > 0.0 ? width * height * count * rounds / total / 1000000.0 : 0.0);
+    return result;
+}
+
+int main (int argc, char* argv[])
+{
+    FILE* out = (argc > 1 ? fopen (argv[1], "w") : stdout);
+    if (!out)
+    {
+        fprintf (stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    // Image fill: horizontal gradient
+    cairo_surface_t* image = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 64, 32);
+    cairo_t* cr = cairo_create (image);
+    cairo_pattern_t* pat = cairo_pattern_create_linear (0.0, 0.0, 64.0, 0.0);
+    cairo_pattern_add_color_stop_rgba (pat, 0.0, 0.2, 0.2, 0.2, 1.0);
+    cairo_pattern_add_color_stop_rgba (pat, 1.0, 0.6, 0.6, 0.6, 1.0);
+    cairo_set_source (cr, pat);
+    cairo_paint (cr);
+    cairo_pattern_destroy (pat);
+    cairo_destroy (cr);
+    const BStyles::Fill imageFill = BStyles::Fill (image);
+    cairo_surface_destroy (image);
+
+    const BStyles::Fill translucentFill = BStyles::Fill (BStyles::Color (0.2, 0.4, 0.6, 0.5));
+    const BStyles::Border roundedBorder = BStyles::Border (BStyles::greyLine1pt, 0.0, 0.0, 4.0);
+
+    const std::vector<std::function<Result ()>> scenarios =
+    {
+        [] () {return measure ("none", "pixels", 64, 32, [] (Widget& w) {});},
+        [] () {return measure ("solid", "pixels", 64, 32, [] (Widget& w) {w.setBackground (BStyles::darkgreyFill);});},
+        [] ()
+        {
+            return measure
+            (
+                "solid_border", "pixels", 64, 32,
+                [] (Widget& w) {w.setBackground (BStyles::darkgreyFill); w.setBorder (BStyles::greyBorder1pt);}
+            );
+        },
+        [&] ()
+        {
+            return measure
+            (
+                "translucent_border", "pixels", 64, 32,
+                [&] (Widget& w) {w.setBackground (translucentFill); w.setBorder (BStyles::shadow50Border2pt);}
+            );
+        },
+        [] ()
+        {
+            return measure
+            (
+                "solid_border_unaligned", "cairo", 64.5, 32.5,
+                [] (Widget& w) {w.setBackground (BStyles::darkgreyFill); w.setBorder (BStyles::greyBorder1pt);}
+            );
+        },
+        [&] ()
+        {
+            return measure
+            (
+                "solid_rounded_border", "cairo", 64, 32,
+                [&] (Widget& w) {w.setBackground (BStyles::darkgreyFill); w.setBorder (roundedBorder);}
+            );
+        },
+        [&] ()
+        {
+            return measure
+            (
+                "image_border", "cairo", 64, 32,
+                [&] (Widget& w) {w.setBackground (imageFill); w.setBorder (BStyles::greyBorder1pt);}
+            );
+        }
+    };
+
+    fprintf (out, "{\n    \"benchmark\": \"background\",\n    \"simd\": \"%s\",\n    \"scenarios\": [\n", cairoplus_pixel_simd ());
+    for (size_t i = 0; i < scenarios.size(); ++i)
+    {
+        const Result r = scenarios[i] ();
+        fprintf
+        (
+            out,
+            "        {\"name\": \"%s\", \"expected_path\": \"%s\", \"us_per_widget\": %.3f, \"mpixels_per_s\": %.1f}%s\n",
+            r.name.c_str(), r.expectedPath.c_str(), r.usPerWidget, r.mpixelsPerSecond,
+            (i + 1 < scenarios.size() ? "," : "")
+        );
+        fflush (out);
+    }
+    fprintf (out, "    ]\n}\n");
+
+    if (out != stdout) fclose (out);
+    return 0;
+}
@@ -0,0 +1,129 @@
+/* eventqueue.cpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Micro-benchmark: Cost of Window::addEventToQueue as a function of the 
+// event queue depth. The queue is pre-filled with non-mergeable key events.
+// Then mergeable pointer motion events and non-mergeable button events are
+// added and the mean time per added event is measured.
+// Results are written as JSON to stdout (or to the file passed as first
+// argument), one scenario per queue depth:
+// * merge_ns_per_event: mean time per added mergeable event in nanoseconds,
+// * append_ns_per_event: mean time per added non-mergeable event in
+//   nanoseconds.
+
+#include "../BWidgets/Window.hpp"
+#include "../BWidgets/Widget.hpp"
+#include "../BEvents/KeyEvent.hpp"
+#include "../BEvents/PointerEvent.hpp"
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+using namespace BWidgets;
+
+int main (int argc, char* argv[])
+{
+    FILE* out = (argc > 1 ? fopen (argv[1], "w") : stdout);
+    if (!out)
+    {
+        fprintf (stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    constexpr size_t nrWidgets = 64;
+    constexpr size_t nrEvents = 100000;
+    const std::array<size_t, 5> depths = {0, 100, 1000, 10000, 100000};
+
+    Window window;
+    std::vector<std::unique_ptr<Widget>> widgets;
+    for (size_t i = 0; i < nrWidgets; ++i) 
+    {
+        widgets.push_back (std::unique_ptr<Widget> (new Widget ()));
+        widgets.back()->setEventMergeable (BEvents::Event::EventType::pointerMotionEvent, true);
+    }
+
+    fprintf (out, "{\n    \"benchmark\": \"eventqueue\",\n    \"scenarios\": [\n");
+    for (size_t d = 0; d < depths.size(); ++d)
+    {
+        const size_t depth = depths[d];
+        window.purgeEventQueue ();
+        for (size_t i = 0; i < depth; ++i)
+        {
+            window.addEventToQueue 
+            (
+                window.createEvent<BEvents::KeyEvent> (widgets[i % nrWidgets].get(), BEvents::Event::EventType::keyPressEvent, 0.0, 0.0, 0x61)
+            );
+        }
+
+        // Mergeable events
+        std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < nrEvents; ++i)
+        {
+            window.addEventToQueue 
+            (
+                window.createEvent<BEvents::PointerEvent> 
+                (
+                    widgets[i % nrWidgets].get(), 
+                    BEvents::Event::EventType::pointerMotionEvent,
+                    BUtilities::Point<> (i % 100, 0.0),
+                    BUtilities::Point<> (),
+                    BUtilities::Point<> (1.0, 0.0),
+                    BDevices::MouseButton::ButtonType::none
+                )
+            );
+        }
+        std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+        // Non-mergeable events
+        for (size_t i = 0; i < nrEvents; ++i)
+        {
+            window.addEventToQueue 
+            (
+                window.createEvent<BEvents::PointerEvent> 
+                (
+                    widgets[i % nrWidgets].get(), 
+                    BEvents::Event::EventType::buttonPressEvent,
+                    BUtilities::Point<> (i % 100, 0.0),
+                    BUtilities::Point<> (),
+                    BUtilities::Point<> (),
+                    BDevices::MouseButton::ButtonType::left
+                )
+            );
+        }
+        std::chrono::steady_clock::time_point t2 = std::chrono::steady_clock::now();
+
+        fprintf 
+        (
+            out,
+            "        {\"name\": \"depth_%zu\", \"depth\": %zu, \"merge_ns_per_event\": %.1f, \"append_ns_per_event\": %.1f}%s\n", 
+            depth,
+            depth, 
+            std::chrono::duration<double, std::nano> (t1 - t0).count() / nrEvents,
+            std::chrono::duration<double, std::nano> (t2 - t1).count() / nrEvents,
+            (d + 1 < depths.size() ? "," : "")
+        );
+        fflush (out);
+    }
+    fprintf (out, "    ]\n}\n");
+
+    window.purgeEventQueue ();
+
+    if (out != stdout) fclose (out);
+    return 0;
+}
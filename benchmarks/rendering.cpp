@@ -0,0 +1,367 @@
+/* rendering.cpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Benchmark suite: Rendering and event dispatch scenarios. Each scenario
+// runs a fixed number of frames in an offscreen window. A frame is a
+// scenario step (e.g., value changes or emulated host events) followed by
+// Window::handleEvents() which dispatches all events and composes the
+// frame. Results are written as JSON to stdout (or to the file passed as
+// first argument):
+// * fps: frames per second,
+// * frame_time_p50_ms, frame_time_p99_ms: median and 99th percentile frame
+//   time,
+// * allocations_per_frame: mean number of heap allocations per frame,
+// * peak_surface_bytes: peak memory of all widget surfaces and of the
+//   surface pool.
+
+#include "../BWidgets/Window.hpp"
+#include "../BWidgets/Widget.hpp"
+#include "../BWidgets/Frame.hpp"
+#include "../BWidgets/Label.hpp"
+#include "../BWidgets/HMeter.hpp"
+#include "../BWidgets/Pattern.hpp"
+#include "../BWidgets/FileChooser.hpp"
+#include "../BWidgets/TextBox.hpp"
+#include "../BStyles/Theme.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#define URI "https://github.com/sjaehn/BWidgets/benchmarks/rendering.cpp"
+
+using namespace BWidgets;
+
+// Allocation counter
+static std::atomic<size_t> allocations (0);
+
+void* operator new (size_t size)
+{
+    allocations.fetch_add (1, std::memory_order_relaxed);
+    void* p = std::malloc (size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new (size_t size, const std::nothrow_t&) noexcept
+{
+    allocations.fetch_add (1, std::memory_order_relaxed);
+    return std::malloc (size ? size : 1);
+}
+
+void* operator new[] (size_t size) {return operator new (size);}
+
+void* operator new[] (size_t size, const std::nothrow_t& tag) noexcept {return operator new (size, tag);}
+
+void operator delete (void* p) noexcept {std::free (p);}
+
+void operator delete (void* p, size_t size) noexcept {std::free (p);}
+
+void operator delete (void* p, const std::nothrow_t&) noexcept {std::free (p);}
+
+void operator delete[] (void* p) noexcept {std::free (p);}
+
+void operator delete[] (void* p, size_t size) noexcept {std::free (p);}
+
+void operator delete[] (void* p, const std::nothrow_t&) noexcept {std::free (p);}
+
+struct Result
+{
+    std::string name;
+    size_t frames;
+    double fps;
+    double p50;
+    double p99;
+    double allocationsPerFrame;
+    size_t peakSurfaceBytes;
+};
+
+static size_t surfaceBytes (const Window& window)
+{
+    return window.getTotalSurfaceBytes() + Visualizable::getSurfacePool().getBytes();
+}
+
+static Result measure (const std::string& name, Window& window, const size_t frames, std::function<void (size_t frame)> step)
+{
+    // Don't count surfaces pooled by previous scenarios
+    Visualizable::getSurfacePool().clear();
+
+    // Warm up: Initial draw
+    window.handleEvents ();
+
+    std::vector<double> times;
+    times.reserve (frames);
+    size_t peak = surfaceBytes (window);
+    const size_t allocations0 = allocations.load();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < frames; ++i)
+    {
+        const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+        step (i);
+        window.handleEvents ();
+        times.push_back (std::chrono::duration<double, std::milli> (std::chrono::steady_clock::now() - t0).count());
+        peak = std::max (peak, surfaceBytes (window));
+    }
+
+    const double total = std::chrono::duration<double> (std::chrono::steady_clock::now() - start).count();
+    const size_t allocs = allocations.load() - allocations0;
+    std::sort (times.begin(), times.end());
+
+    Result r;
+    r.name = name;
+    r.frames = frames;
+    r.fps = (total > 0.0 ? frames / total : 0.0);
+    r.p50 = times[(frames - 1) / 2];
+    r.p99 = times[std::min (static_cast<size_t> (std::ceil (0.99 * frames)), frames) - 1];
+    r.allocationsPerFrame = static_cast<double> (allocs) / frames;
+    r.peakSurfaceBytes = peak;
+    return r;
+}
+
+// 100 frames with 100 widgets each (10000 widgets). Each frame updates 100
+// widgets spread over the window and re-exposes the whole window.
+static Result widgetTree ()
+{
+    Window window (1000, 1000, Window::Offscreen());
+    std::vector<std::unique_ptr<Frame>> frames;
+    std::vector<std::unique_ptr<Widget>> widgets;
+    for (size_t i = 0; i < 100; ++i)
+    {
+        frames.push_back (std::unique_ptr<Frame> (new Frame ((i % 10) * 100, (i / 10) * 100, 100, 100)));
+        window.add (frames.back().get());
+        for (size_t j = 0; j < 99; ++j)
+        {
+            widgets.push_back (std::unique_ptr<Widget> (new Widget ((j % 10) * 10, (j / 10) * 10, 8, 8)));
+            frames.back()->add (widgets.back().get());
+        }
+    }
+
+    Result r = measure
+    (
+        "widget_tree_10k", window, 200,
+        [&] (size_t frame)
+        {
+            for (size_t i = 0; i < 100; ++i) widgets[(frame * 7 + i * 99) % widgets.size()]->update();
+            window.emitExposeEvent();
+        }
+    );
+
+    for (std::unique_ptr<Frame>& f : frames) window.release (f.get());
+    return r;
+}
+
+// 256 meters. Each frame sets new values to all meters (values for 60 Hz
+// updates of sines with different frequencies).
+static Result meters ()
+{
+    Window window (800, 640, Window::Offscreen());
+    std::vector<std::unique_ptr<HMeter>> meters;
+    for (size_t i = 0; i < 256; ++i)
+    {
+        meters.push_back (std::unique_ptr<HMeter> (new HMeter ((i % 8) * 100, (i / 8) * 20, 90, 16, 0.0, 0.0, 1.0)));
+        window.add (meters.back().get());
+    }
+
+    Result r = measure
+    (
+        "meters_256_60hz", window, 600,
+        [&] (size_t frame)
+        {
+            const double t = frame / 60.0;
+            for (size_t i = 0; i < meters.size(); ++i) meters[i]->setValue (0.5 + 0.5 * std::sin (2.0 * M_PI * (0.5 + 0.05 * i) * t));
+        }
+    );
+
+    for (std::unique_ptr<HMeter>& m : meters) window.release (m.get());
+    return r;
+}
+
+// Drag across a 64 x 32 pattern: Emulated host button press, motion across
+// the whole pattern, and release.
+static Result patternDrag ()
+{
+    Window window (1040, 540, Window::Offscreen());
+    Pattern pattern (20, 20, 1000, 500, 64, 32);
+    window.add (&pattern);
+
+    const size_t frames = 500;
+    Result r = measure
+    (
+        "pattern_drag_64x32", window, frames,
+        [&] (size_t frame)
+        {
+            const BUtilities::Point<> p = BUtilities::Point<> (25.0 + 990.0 * frame / (frames - 1), 25.0 + 490.0 * frame / (frames - 1));
+            if (frame == 0) window.sendButtonEvent (p, 0, true);
+            else window.sendMotionEvent (p);
+            if (frame == frames - 1) window.sendButtonEvent (p, 0, false);
+        }
+    );
+
+    window.release (&pattern);
+    return r;
+}
+
+// FileChooser on a directory with 20000 entries. Each frame re-reads the
+// directory.
+static Result fileChooser ()
+{
+    char dir[] = "/tmp/bwidgets-bench-XXXXXX";
+    if (!mkdtemp (dir)) return Result {"filechooser_20k", 0, 0.0, 0.0, 0.0, 0.0, 0};
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        const std::string filename = std::string (dir) + "/file" + std::to_string (i) + ".txt";
+        FILE* f = fopen (filename.c_str(), "w");
+        if (f) fclose (f);
+    }
+
+    Result r;
+    {
+        Window window (800, 600, Window::Offscreen());
+        FileChooser chooser (0, 0, 800, 600, dir);
+        window.add (&chooser);
+
+        r = measure
+        (
+            "filechooser_20k", window, 20,
+            [&] (size_t frame)
+            {
+                // Different path string, same directory: Forces re-reading
+                chooser.setPath (std::string (dir) + (frame % 2 ? "/." : "/./."));
+            }
+        );
+
+        window.release (&chooser);
+    }
+
+    for (size_t i = 0; i < 20000; ++i) unlink ((std::string (dir) + "/file" + std::to_string (i) + ".txt").c_str());
+    rmdir (dir);
+    return r;
+}
+
+// Theme switch on 5000 labels. Each frame applies one of two themes to the
+// whole window.
+static Result themeSwitch ()
+{
+    Window window (1000, 1000, Window::Offscreen(), BUtilities::Urid::urid (URI "/window"));
+    std::vector<std::unique_ptr<Label>> labels;
+    for (size_t i = 0; i < 5000; ++i)
+    {
+        labels.push_back (std::unique_ptr<Label> (new Label ((i % 50) * 20, (i / 50) * 10, 20, 10, "Label", BUtilities::Urid::urid (URI "/label"))));
+        window.add (labels.back().get());
+    }
+
+    const BStyles::Theme themes[2] =
+    {
+        BStyles::Theme
+        {
+            {
+                BUtilities::Urid::urid (URI "/label"),
+                BStyles::Style
+                ({
+                    {BUtilities::Urid::urid (BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font> (BStyles::sans12pt)},
+                    {BUtilities::Urid::urid (BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap> (BStyles::whites)}
+                })
+            }
+        },
+        BStyles::Theme
+        {
+            {
+                BUtilities::Urid::urid (URI "/label"),
+                BStyles::Style
+                ({
+                    {BUtilities::Urid::urid (BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font> (BStyles::Font ("Sans", CAIRO_FONT_SLANT_NORMAL, CAIRO_FONT_WEIGHT_BOLD, 10.0))},
+                    {BUtilities::Urid::urid (BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap> (BStyles::reds)}
+                })
+            }
+        }
+    };
+
+    Result r = measure
+    (
+        "theme_switch_5k", window, 20,
+        [&] (size_t frame) {window.setTheme (themes[frame % 2]);}
+    );
+
+    for (std::unique_ptr<Label>& l : labels) window.release (l.get());
+    return r;
+}
+
+// Text-heavy TextBox. Each frame changes the width of the box which causes
+// a new layout of the text.
+static Result textBoxLayout ()
+{
+    std::string text;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        text += "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. ";
+    }
+
+    Window window (800, 800, Window::Offscreen());
+    TextBox textBox (0, 0, 600, 800, text);
+    window.add (&textBox);
+
+    Result r = measure
+    (
+        "textbox_layout", window, 100,
+        [&] (size_t frame) {textBox.resize (400.0 + 4.0 * (frame % 100), 800.0);}
+    );
+
+    window.release (&textBox);
+    return r;
+}
+
+int main (int argc, char* argv[])
+{
+    FILE* out = (argc > 1 ? fopen (argv[1], "w") : stdout);
+    if (!out)
+    {
+        fprintf (stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    const std::vector<std::function<Result ()>> scenarios =
+    {
+        widgetTree, meters, patternDrag, fileChooser, themeSwitch, textBoxLayout
+    };
+
+    fprintf (out, "{\n    \"benchmark\": \"rendering\",\n    \"scenarios\": [\n");
+    for (size_t i = 0; i < scenarios.size(); ++i)
+    {
+        const Result r = scenarios[i] ();
+        fprintf
+        (
+            out,
+            "        {\"name\": \"%s\", \"frames\": %zu, \"fps\": %.2f, \"frame_time_p50_ms\": %.3f, \"frame_time_p99_ms\": %.3f, \"allocations_per_frame\": %.1f, \"peak_surface_bytes\": %zu}%s\n",
+            r.name.c_str(), r.frames, r.fps, r.p50, r.p99, r.allocationsPerFrame, r.peakSurfaceBytes,
+            (i + 1 < scenarios.size() ? "," : "")
+        );
+        fflush (out);
+    }
+    fprintf (out, "    ]\n}\n");
+
+    if (out != stdout) fclose (out);
+    return 0;
+}
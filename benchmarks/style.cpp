@@ -0,0 +1,232 @@
+/* style.cpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Benchmark: Style copy and lookup. Uses a widget style with all built-in
+// style properties and a nested style (as used by composite widgets) and a
+// small style with small trivially copyable properties (colors, lines,
+// borders) only. The image background lookup uses a 512 x 512 (1 MB) image
+// fill.
+// Results are written as JSON to stdout (or to the file passed as first
+// argument):
+// * ns_per_op: mean time per operation in nanoseconds,
+// * allocations_per_op: mean number of heap allocations per operation.
+
+#include "../BStyles/Style.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#define URI "https://github.com/sjaehn/BWidgets/benchmarks/style.cpp"
+
+// Allocation counter
+static std::atomic<size_t> allocations (0);
+
+void* operator new (size_t size)
+{
+    allocations.fetch_add (1, std::memory_order_relaxed);
+    void* p = std::malloc (size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    return p;
+}
+
+void* operator new (size_t size, const std::nothrow_t&) noexcept
+{
+    allocations.fetch_add (1, std::memory_order_relaxed);
+    return std::malloc (size ? size : 1);
+}
+
+void* operator new[] (size_t size) {return operator new (size);}
+
+void* operator new[] (size_t size, const std::nothrow_t& tag) noexcept {return operator new (size, tag);}
+
+void operator delete (void* p) noexcept {std::free (p);}
+
+void operator delete (void* p, size_t size) noexcept {std::free (p);}
+
+void operator delete (void* p, const std::nothrow_t&) noexcept {std::free (p);}
+
+void operator delete[] (void* p) noexcept {std::free (p);}
+
+void operator delete[] (void* p, size_t size) noexcept {std::free (p);}
+
+void operator delete[] (void* p, const std::nothrow_t&) noexcept {std::free (p);}
+
+struct Result
+{
+    std::string name;
+    double nsPerOp;
+    double allocationsPerOp;
+};
+
+// Prevents the compiler from dropping the measured operations
+static volatile double sink = 0.0;
+
+static Result measure (const std::string& name, const size_t ops, std::function<void ()> op)
+{
+    // Warm up
+    for (size_t i = 0; i < ops / 10; ++i) op ();
+
+    const size_t allocations0 = allocations.load();
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < ops; ++i) op ();
+    const double total = std::chrono::duration<double, std::nano> (std::chrono::steady_clock::now() - start).count();
+    const size_t allocs = allocations.load() - allocations0;
+
+    return Result {name, total / ops, static_cast<double> (allocs) / ops};
+}
+
+int main (int argc, char* argv[])
+{
+    FILE* out = (argc > 1 ? fopen (argv[1], "w") : stdout);
+    if (!out)
+    {
+        fprintf (stderr, "Can't open %s\n", argv[1]);
+        return 1;
+    }
+
+    BStyles::Style style;
+    style.setBorder (BStyles::greyBorder1pt);
+    style.setBackground (BStyles::darkgreyFill);
+    style.setFont (BStyles::sans12pt);
+    style.setFgColors (BStyles::greens);
+    style.setBgColors (BStyles::darks);
+    style.setTxColors (BStyles::whites);
+    style[BUtilities::Urid::urid (URI "/color")] = BUtilities::makeAny<BStyles::Color> (BStyles::white);
+    style[BUtilities::Urid::urid (URI "/line")] = BUtilities::makeAny<BStyles::Line> (BStyles::greyLine1pt);
+    BStyles::Style nested = style;
+    style[BUtilities::Urid::urid (URI "/label")] = BUtilities::makeAny<BStyles::Style> (nested);
+
+    BStyles::Style small;
+    small.setBorder (BStyles::greyBorder1pt);
+    small[BUtilities::Urid::urid (URI "/color")] = BUtilities::makeAny<BStyles::Color> (BStyles::white);
+    small[BUtilities::Urid::urid (URI "/line")] = BUtilities::makeAny<BStyles::Line> (BStyles::greyLine1pt);
+    small[BUtilities::Urid::urid (URI "/hicolor")] = BUtilities::makeAny<BStyles::Color> (BStyles::red);
+
+    cairo_surface_t* image = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 512, 512);
+    BStyles::Style imageStyle;
+    imageStyle.setBackground (BStyles::Fill (image));
+    cairo_surface_destroy (image);
+
+    const std::vector<std::function<Result ()>> scenarios =
+    {
+        [&] ()
+        {
+            return measure
+            (
+                "style_copy", 100000,
+                [&] ()
+                {
+                    BStyles::Style s = style;
+                    sink = sink + s.size();
+                }
+            );
+        },
+        [&] ()
+        {
+            return measure
+            (
+                "small_style_copy", 100000,
+                [&] ()
+                {
+                    BStyles::Style s = small;
+                    sink = sink + s.size();
+                }
+            );
+        },
+        [&] ()
+        {
+            BStyles::Style s;
+            return measure
+            (
+                "style_assign", 100000,
+                [&] ()
+                {
+                    s = style;
+                    sink = sink + s.size();
+                }
+            );
+        },
+        [&] ()
+        {
+            return measure
+            (
+                "style_lookup_border", 1000000,
+                [&] () {sink = sink + style.getBorder().line.width;}
+            );
+        },
+        [&] ()
+        {
+            return measure
+            (
+                "style_lookup_background", 1000000,
+                [&] () {sink = sink + style.getBackground().getColor().alpha;}
+            );
+        },
+        [&] ()
+        {
+            return measure
+            (
+                "style_lookup_image_background", 10000,
+                [&] () {sink = sink + (imageStyle.getBackground().isColor() ? 0.0 : 1.0);}
+            );
+        },
+        [&] ()
+        {
+            const uint32_t urid = BUtilities::Urid::urid (URI "/color");
+            return measure
+            (
+                "style_lookup_color", 1000000,
+                [&] () {sink = sink + style.find (urid)->second.get<BStyles::Color>().red;}
+            );
+        },
+        [&] ()
+        {
+            return measure
+            (
+                "style_lookup_all", 100000,
+                [&] ()
+                {
+                    sink = sink + style.getBorder().line.width + style.getBackground().getColor().alpha + style.getFont().size +
+                           style.getFgColors().size() + style.getBgColors().size() + style.getTxColors().size();
+                }
+            );
+        }
+    };
+
+    fprintf (out, "{\n    \"benchmark\": \"style\",\n    \"scenarios\": [\n");
+    for (size_t i = 0; i < scenarios.size(); ++i)
+    {
+        const Result r = scenarios[i] ();
+        fprintf
+        (
+            out,
+            "        {\"name\": \"%s\", \"ns_per_op\": %.1f, \"allocations_per_op\": %.2f}%s\n",
+            r.name.c_str(), r.nsPerOp, r.allocationsPerOp,
+            (i + 1 < scenarios.size() ? "," : "")
+        );
+        fflush (out);
+    }
+    fprintf (out, "    ]\n}\n");
+
+    if (out != stdout) fclose (out);
+    return 0;
+}
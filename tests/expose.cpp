@@ -0,0 +1,87 @@
+/* expose.cpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Regression test: The expose request of an updated widget covers the 
+// family area of the widget, including children escaping the widget to the
+// left or above. Returns 0 on success, otherwise 1.
+
+#include "../BWidgets/Window.hpp"
+#include "../BWidgets/Widget.hpp"
+#include "../BEvents/ExposeEvent.hpp"
+#include <cstdio>
+
+using namespace BWidgets;
+
+// Offscreen window recording the area of all expose requests
+class ExposeWindow : public Window
+{
+public:
+    BUtilities::Area<> exposed;
+
+    ExposeWindow () : Window (200, 200, Window::Offscreen()), exposed () {}
+
+    virtual void onExposeRequest (BEvents::Event* event) override
+    {
+        BEvents::ExposeEvent* ev = dynamic_cast<BEvents::ExposeEvent*> (event);
+        if (ev)
+        {
+            if (exposed == BUtilities::Area<> ()) exposed = ev->getArea();
+            else exposed.extend (ev->getArea());
+        }
+        Window::onExposeRequest (event);
+    }
+};
+
+// Child widget escaping its parent widget
+class EscapingWidget : public Widget
+{
+public:
+    EscapingWidget (const double x, const double y, const double width, const double height) :
+        Widget (x, y, width, height)
+    {
+        setStacking (StackingType::escape);
+    }
+};
+
+int main ()
+{
+    ExposeWindow window;
+    Widget parent (50, 50, 20, 20);
+    EscapingWidget child (-20, -20, 10, 10);
+    window.add (&parent);
+    parent.add (&child);
+    window.handleEvents ();
+
+    window.exposed = BUtilities::Area<> ();
+    parent.update ();
+    window.handleEvents ();
+
+    const BUtilities::Area<> expected (30, 30, 40, 40);
+    BUtilities::Area<> covered = window.exposed;
+    covered.extend (expected);
+    const bool ok = (covered == window.exposed);
+
+    printf 
+    (
+        "family area (%g, %g, %g, %g), exposed (%g, %g, %g, %g): %s\n",
+        expected.getX(), expected.getY(), expected.getWidth(), expected.getHeight(),
+        window.exposed.getX(), window.exposed.getY(), window.exposed.getWidth(), window.exposed.getHeight(),
+        (ok ? "ok" : "FAILED")
+    );
+
+    return (ok ? 0 : 1);
+}
@@ -0,0 +1,198 @@
+/* pixels.cpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Correctness test of the cairoplus pixel functions: Random premultiplied
+// ARGB32 rows (including runs of transparent and opaque pixels) of different
+// (also odd) widths are painted over random rows by each instruction set
+// supported by the CPU. The results are compared to the scalar functions
+// (exact) and to Cairo CAIRO_OPERATOR_OVER (at most 1 per channel). Rows are
+// also filled with solid pixel values by each instruction set. Pixel
+// values from cairoplus_pixel_from_rgba() are compared to Cairo fills with
+// cairo_set_source_rgba(). Returns 0 on success, otherwise 1.
+
+#include "../BUtilities/cairoplus.h"
+#include <cairo/cairo.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+static uint32_t getPixel (cairo_surface_t* surface, const int x, const int y)
+{
+    cairo_surface_flush (surface);
+    const unsigned char* data = cairo_image_surface_get_data (surface);
+    const int stride = cairo_image_surface_get_stride (surface);
+    return reinterpret_cast<const uint32_t*> (data + y * stride)[x];
+}
+
+static void setRow (cairo_surface_t* surface, const std::vector<uint32_t>& row)
+{
+    cairo_surface_flush (surface);
+    uint32_t* data = reinterpret_cast<uint32_t*> (cairo_image_surface_get_data (surface));
+    for (size_t i = 0; i < row.size(); ++i) data[i] = row[i];
+    cairo_surface_mark_dirty (surface);
+}
+
+// Maximum difference of all channels
+static int difference (const uint32_t a, const uint32_t b)
+{
+    int d = 0;
+    for (int i = 0; i < 32; i += 8) d = std::max (d, std::abs (static_cast<int> ((a >> i) & 0xff) - static_cast<int> ((b >> i) & 0xff)));
+    return d;
+}
+
+int main ()
+{
+    constexpr int maxWidth = 67;
+    constexpr int nrRows = 200;
+    const char* simds[] = {"scalar", "sse2", "avx2", "neon"};
+
+    std::minstd_rand rnd (1);
+    auto random = [&rnd] (const uint32_t n) {return static_cast<uint32_t> (rnd() % n);};
+
+    // Random premultiplied pixel, transparent or opaque in runs (to cover
+    // the skip and copy paths)
+    uint32_t mode = 0;
+    auto randomPixel = [&] ()
+    {
+        if (random (4) == 0) mode = random (3);
+        const uint32_t a = (mode == 0 ? 0 : (mode == 1 ? 0xff : random (256)));
+        uint32_t p = a << 24;
+        for (int i = 0; i < 24; i += 8) p |= random (a + 1) << i;
+        return p;
+    };
+
+    // Random rows of all widths
+    std::vector<std::vector<uint32_t>> srcRows;
+    std::vector<std::vector<uint32_t>> dstRows;
+    for (int j = 0; j < nrRows; ++j)
+    {
+        const int width = 1 + j % maxWidth;
+        std::vector<uint32_t> src;
+        std::vector<uint32_t> dst;
+        for (int i = 0; i < width; ++i) src.push_back (randomPixel ());
+        for (int i = 0; i < width; ++i) dst.push_back (randomPixel ());
+        srcRows.push_back (src);
+        dstRows.push_back (dst);
+    }
+
+    // Reference: Scalar functions and Cairo
+    std::vector<std::vector<uint32_t>> scalarRows;
+    std::vector<std::vector<uint32_t>> cairoRows;
+    cairoplus_pixel_set_simd ("scalar");
+    for (int j = 0; j < nrRows; ++j)
+    {
+        const int width = srcRows[j].size();
+        cairo_surface_t* src = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, 1);
+        cairo_surface_t* dst = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, 1);
+
+        setRow (src, srcRows[j]);
+        setRow (dst, dstRows[j]);
+        cairoplus_image_surface_over_rect (dst, 0, 0, src, 0, 0, width, 1);
+        scalarRows.push_back (std::vector<uint32_t> ());
+        for (int i = 0; i < width; ++i) scalarRows.back().push_back (getPixel (dst, i, 0));
+
+        setRow (dst, dstRows[j]);
+        cairo_t* cr = cairo_create (dst);
+        cairo_set_source_surface (cr, src, 0, 0);
+        cairo_set_operator (cr, CAIRO_OPERATOR_OVER);
+        cairo_paint (cr);
+        cairo_destroy (cr);
+        cairoRows.push_back (std::vector<uint32_t> ());
+        for (int i = 0; i < width; ++i) cairoRows.back().push_back (getPixel (dst, i, 0));
+
+        cairo_surface_destroy (src);
+        cairo_surface_destroy (dst);
+    }
+
+    size_t nrFailed = 0;
+    auto fail = [&nrFailed] (const char* simd, const char* ref, const int width, const int x, const uint32_t result, const uint32_t expected)
+    {
+        ++nrFailed;
+        if (nrFailed <= 10) fprintf (stderr, "%s: width %i, pixel %i: %08x, %s: %08x\n", simd, width, x, result, ref, expected);
+    };
+
+    // Each supported instruction set
+    for (const char* simd : simds)
+    {
+        if (!cairoplus_pixel_set_simd (simd)) continue;
+
+        for (int j = 0; j < nrRows; ++j)
+        {
+            const int width = srcRows[j].size();
+            cairo_surface_t* src = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, 1);
+            cairo_surface_t* dst = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, width, 1);
+            setRow (src, srcRows[j]);
+            setRow (dst, dstRows[j]);
+            cairoplus_image_surface_over_rect (dst, 0, 0, src, 0, 0, width, 1);
+
+            for (int i = 0; i < width; ++i)
+            {
+                const uint32_t p = getPixel (dst, i, 0);
+                if (p != scalarRows[j][i]) fail (simd, "scalar", width, i, p, scalarRows[j][i]);
+                if (difference (p, cairoRows[j][i]) > 1) fail (simd, "cairo", width, i, p, cairoRows[j][i]);
+            }
+
+            // Solid fill
+            const uint32_t pixel = srcRows[j][0];
+            cairoplus_surface_fill_area (dst, 0, 0, width, 1, pixel);
+            for (int i = 0; i < width; ++i)
+            {
+                const uint32_t p = getPixel (dst, i, 0);
+                if (p != pixel) fail (simd, "fill", width, i, p, pixel);
+            }
+
+            cairo_surface_destroy (src);
+            cairo_surface_destroy (dst);
+        }
+
+        printf ("over and fill %s: %i rows compared\n", simd, nrRows);
+    }
+    cairoplus_pixel_set_simd (nullptr);
+
+    // Color conversion
+    constexpr int nrColors = 10000;
+    cairo_surface_t* surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, 1, 1);
+    for (int i = 0; i < nrColors; ++i)
+    {
+        const double r = random (1001) / 1000.0;
+        const double g = random (1001) / 1000.0;
+        const double b = random (1001) / 1000.0;
+        const double a = random (1001) / 1000.0;
+
+        cairo_t* cr = cairo_create (surface);
+        cairo_set_source_rgba (cr, r, g, b, a);
+        cairo_set_operator (cr, CAIRO_OPERATOR_SOURCE);
+        cairo_paint (cr);
+        cairo_destroy (cr);
+
+        const uint32_t p = cairoplus_pixel_from_rgba (r, g, b, a);
+        const uint32_t expected = getPixel (surface, 0, 0);
+        if (p != expected)
+        {
+            ++nrFailed;
+            if (nrFailed <= 10) fprintf (stderr, "rgba (%g, %g, %g, %g): %08x, cairo: %08x\n", r, g, b, a, p, expected);
+        }
+    }
+    cairo_surface_destroy (surface);
+    printf ("rgba: %i colors compared\n", nrColors);
+
+    printf ("%zu differences: %s\n", nrFailed, (nrFailed == 0 ? "ok" : "FAILED"));
+    return (nrFailed == 0 ? 0 : 1);
+}
@@ -0,0 +1,266 @@
+/* stylecascade.cpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Differential test: Styles pushed to child widgets (resolved lazily) are
+// compared to a reference model of the eager style cascade of previous
+// versions. Random operations (setStyle(), setTheme(), moving a widget to
+// another parent) are applied to a random widget tree and to the reference
+// model. The widget tree is either linked to an offscreen window (styles are
+// resolved by the main window or by resolveStyles()) or not linked (styles
+// are resolved right away). After each operation, the styles of all widgets
+// are compared to the reference. Returns 0 on success, otherwise 1.
+
+#include "../BWidgets/Window.hpp"
+#include "../BWidgets/Widget.hpp"
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#define URI "https://github.com/sjaehn/BWidgets/tests/stylecascade.cpp"
+
+using namespace BWidgets;
+
+// Reference model: Eager style cascade of previous versions
+struct Node
+{
+    uint32_t urid;
+    BStyles::Style style;
+    BStyles::Theme theme;
+    Node* parent;
+    std::vector<Node*> children;
+};
+
+static void setStyle (Node* node, const BStyles::Style& style);
+
+static void pushStyle (Node* child)
+{
+    bool changed = false;
+
+    // 1) Forward styles in nested styles
+    const BStyles::Style& parentStyle = child->parent->style;
+    BStyles::Style::const_iterator it = parentStyle.find (child->urid);
+    if ((it != parentStyle.end()) && parentStyle.isStyle (it))
+    {
+        setStyle (child, it->second.get<BStyles::Style>());
+        changed = true;
+    }
+
+    // 2) Forward styles from themes
+    for (Node* p = child; p != nullptr; p = p->parent)
+    {
+        BStyles::Theme::const_iterator t = p->theme.find (child->urid);
+        if (t != p->theme.end())
+        {
+            setStyle (child, t->second);
+            changed = true;
+            break;
+        }
+    }
+
+    // 3) No change, only to proceed the cascade
+    if (!changed) setStyle (child, child->style);
+}
+
+static void setStyle (Node* node, const BStyles::Style& style)
+{
+    const BStyles::Style s = style;
+    node->style = s;
+    for (Node* c : node->children) pushStyle (c);
+}
+
+static void setTheme (Node* node, const BStyles::Theme& theme)
+{
+    node->theme = theme;
+    BStyles::Theme::const_iterator t = node->theme.find (node->urid);
+    if (t != node->theme.end()) setStyle (node, t->second);
+    else setStyle (node, node->style);
+}
+
+static void add (Node* parent, Node* child)
+{
+    child->parent = parent;
+    parent->children.push_back (child);
+    pushStyle (child);
+}
+
+static void release (Node* child)
+{
+    std::vector<Node*>& siblings = child->parent->children;
+    for (std::vector<Node*>::iterator it = siblings.begin(); it != siblings.end(); ++it)
+    {
+        if (*it == child)
+        {
+            siblings.erase (it);
+            break;
+        }
+    }
+    child->parent = nullptr;
+}
+
+static bool contains (const Node* node, const Node* descendant)
+{
+    for (const Node* n = descendant; n != nullptr; n = n->parent)
+    {
+        if (n == node) return true;
+    }
+    return false;
+}
+
+// Compares styles with color maps and nested styles
+static bool equal (const BStyles::Style& a, const BStyles::Style& b)
+{
+    if (a.size() != b.size()) return false;
+    BStyles::Style::const_iterator j = b.begin();
+    for (BStyles::Style::const_iterator i = a.begin(); i != a.end(); ++i, ++j)
+    {
+        if (i->first != j->first) return false;
+        if (a.isStyle (i) != b.isStyle (j)) return false;
+        if (a.isStyle (i))
+        {
+            if (!equal (i->second.get<BStyles::Style>(), j->second.get<BStyles::Style>())) return false;
+        }
+        else if (i->second.get<BStyles::ColorMap>() != j->second.get<BStyles::ColorMap>()) return false;
+    }
+    return true;
+}
+
+int main ()
+{
+    constexpr size_t nrUrids = 3;
+    constexpr size_t nrWidgets = 16;
+    constexpr size_t nrSeeds = 20;
+    constexpr size_t nrOperations = 500;
+
+    std::vector<uint32_t> urids;
+    for (size_t i = 0; i < nrUrids; ++i) urids.push_back (BUtilities::Urid::urid (URI "#" + std::to_string (i)));
+
+    size_t nrFailed = 0;
+    size_t nrChecked = 0;
+
+    for (size_t seed = 0; seed < nrSeeds; ++seed)
+    {
+        std::minstd_rand rnd (seed + 1);
+        auto random = [&rnd] (const size_t n) {return static_cast<size_t> (rnd() % n);};
+
+        // Random style: a color and optional nested styles
+        std::function<BStyles::Style (int)> randomStyle = [&] (int depth)
+        {
+            BStyles::Style style;
+            const double c = 0.125 * random (8);
+            style.setFgColors (BStyles::ColorMap ({BStyles::Color (c, 0.0, 1.0 - c, 1.0)}));
+            if (depth > 0)
+            {
+                const size_t n = random (3);
+                for (size_t i = 0; i < n; ++i) style[urids[random (nrUrids)]] = BUtilities::makeAny<BStyles::Style> (randomStyle (depth - 1));
+            }
+            return style;
+        };
+
+        auto randomTheme = [&] ()
+        {
+            BStyles::Theme theme;
+            const size_t n = random (3);
+            for (size_t i = 0; i < n; ++i) theme[urids[random (nrUrids)]] = randomStyle (1);
+            return theme;
+        };
+
+        // Random tree below the root widget
+        const bool linked = (seed % 2 == 0);
+        Window window (200, 200, Window::Offscreen());
+        std::vector<std::unique_ptr<Widget>> widgets;
+        std::vector<std::unique_ptr<Node>> nodes;
+        for (size_t i = 0; i < nrWidgets; ++i)
+        {
+            const uint32_t urid = urids[random (nrUrids)];
+            widgets.push_back (std::unique_ptr<Widget> (new Widget (0, 0, 10, 10, urid)));
+            nodes.push_back (std::unique_ptr<Node> (new Node {urid, BStyles::Style(), BStyles::Theme(), nullptr, {}}));
+            if (i > 0)
+            {
+                const size_t p = random (i);
+                widgets[p]->add (widgets[i].get());
+                add (nodes[p].get(), nodes[i].get());
+            }
+        }
+        if (linked) window.add (widgets[0].get());
+        window.handleEvents ();
+
+        for (size_t op = 0; op < nrOperations; ++op)
+        {
+            const size_t i = random (nrWidgets);
+            switch (random (4))
+            {
+                case 0:
+                    {
+                        const BStyles::Style style = randomStyle (2);
+                        widgets[i]->setStyle (style);
+                        setStyle (nodes[i].get(), style);
+                    }
+                    break;
+
+                case 1:
+                    {
+                        const BStyles::Theme theme = randomTheme ();
+                        widgets[i]->setTheme (theme);
+                        setTheme (nodes[i].get(), theme);
+                    }
+                    break;
+
+                case 2:
+                    {
+                        // Move a widget (not the root) to another parent
+                        // outside of its family
+                        const size_t p = random (nrWidgets);
+                        if ((i == 0) || contains (nodes[i].get(), nodes[p].get())) break;
+                        widgets[i]->getParentWidget()->release (widgets[i].get());
+                        widgets[p]->add (widgets[i].get());
+                        release (nodes[i].get());
+                        add (nodes[p].get(), nodes[i].get());
+                    }
+                    break;
+
+                default:
+                    // Some further operations before resolving
+                    continue;
+            }
+
+            // Resolve by the main window or explicitly
+            if (linked)
+            {
+                if (random (2)) window.handleEvents ();
+                else widgets[0]->resolveStyles ();
+            }
+
+            for (size_t j = 0; j < nrWidgets; ++j)
+            {
+                ++nrChecked;
+                if (!equal (widgets[j]->getStyle(), nodes[j]->style))
+                {
+                    ++nrFailed;
+                    if (nrFailed <= 10) fprintf (stderr, "seed %zu, operation %zu: style of widget %zu differs\n", seed, op, j);
+                }
+            }
+        }
+
+        if (linked) window.release (widgets[0].get());
+    }
+
+    printf ("%zu styles compared, %zu differ: %s\n", nrChecked, nrFailed, (nrFailed == 0 ? "ok" : "FAILED"));
+    return (nrFailed == 0 ? 0 : 1);
+}
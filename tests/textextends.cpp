@@ -0,0 +1,47 @@
+/* textextends.cpp
+ * Copyright (C) 2018 - 2023  Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+// Regression test: Text is measured before a widget is shown (and thus
+// before its surface is allocated). Returns 0 on success, otherwise 1.
+
+#include "../BWidgets/Label.hpp"
+#include "../BWidgets/Text.hpp"
+#include <cstdio>
+
+using namespace BWidgets;
+
+static bool check (const char* name, const bool ok)
+{
+    printf ("%s: %s\n", name, (ok ? "ok" : "FAILED"));
+    return ok;
+}
+
+int main ()
+{
+    bool ok = true;
+
+    Label empty ("");
+    Label label ("abc");
+    ok = check ("Label (\"abc\").getWidth() > 0", label.getWidth() > 0.0) && ok;
+    ok = check ("Label (\"abc\") wider than Label (\"\")", label.getWidth() > empty.getWidth()) && ok;
+    ok = check ("Label::getWidth (\"abcdef\") > Label::getWidth (\"abc\")", label.getWidth ("abcdef") > label.getWidth ("abc")) && ok;
+
+    Text text (0, 0, 60, 100, "The quick brown fox jumps over the lazy dog.");
+    ok = check ("Text wraps lines", text.getTextBlock().size() > 1) && ok;
+
+    return (ok ? 0 : 1);
+}